@@ -17,13 +17,20 @@
 #ifndef USCOPE_DRIVER_CONFIGURATION_HPP
 #define USCOPE_DRIVER_CONFIGURATION_HPP
 
+#include <cstdint>
+#include <string>
+
 class configuration {
 public:
     bool debug_hil;
     bool fpga_loaded = false;
+    bool background_acquisition = false;
     unsigned int server_port;
-    static constexpr int n_channels = 6;
-    static constexpr int buffer_size = 1024;
+    uint32_t scope_channels = 6;
+    uint32_t scope_buffer_size = 1024;
+    std::string recordings_dir = "/tmp/uscope_recordings";
+    std::string traces_dir = "/tmp/uscope_traces";
+    std::string hw_sim_dir = "/tmp/uscope_hw_sim";
 };
 
 extern configuration runtime_config;
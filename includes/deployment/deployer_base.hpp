@@ -24,6 +24,8 @@
 #include <memory>
 
 #include "hw_interface/fpga_bridge.hpp"
+#include "hw_interface/hw_address_maps.hpp"
+#include "hw_interface/register_view.hpp"
 #include "deployment/hil_bus_map.hpp"
 #include "deployment/deployment_utilities.hpp"
 
@@ -143,6 +145,7 @@ public:
         spdlog::info("SETUP HIL ADDRESS MAP");
         addresses.parse_layout_object(obj);
         spdlog::trace(addresses.dump());
+        map_layout_regions();
     };
 
     nlohmann::json get_layout_map(){
@@ -152,6 +155,7 @@ public:
 protected:
     bus_address get_bus_address(const output_specs_t& spec){return bus_map.translate_output(spec);}
 
+    void map_layout_regions();
     void write_register(uint64_t addr, uint32_t val);
     void load_core(uint64_t address, const std::vector<uint32_t> &program);
     void setup_core(uint64_t core_address, uint32_t n_channels);
@@ -197,28 +201,4 @@ private:
 };
 
 
-static constexpr struct {
-    uint8_t const_lsb = 0;
-    uint8_t const_hsb = 0x4;
-    uint8_t const_dest = 0x8;
-    uint8_t const_selector = 0xC;
-    uint8_t clear_constant = 0x10;
-    uint8_t active_channels = 0x14;
-    uint8_t const_user = 0x18;
-} fcore_constant_engine;
-
-
-static constexpr struct {
-    uint16_t active_channels = 0x0;
-    uint16_t shape_selector = 0x4;
-    uint16_t channel_selector = 0x8;
-    uint16_t v_on = 0xc;
-    uint16_t v_off = 0x10;
-    uint16_t t_delay = 0x14;
-    uint16_t t_on = 0x18;
-    uint16_t period = 0x1c;
-    uint16_t dest_out = 0x20;
-    uint16_t user_out = 0x24;
-} square_wave_gen;
-
 #endif //USCOPE_DRIVER_DEPLOYER_BASE_HPP
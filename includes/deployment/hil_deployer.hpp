@@ -19,6 +19,8 @@
 
 #include <spdlog/spdlog.h>
 #include <bitset>
+#include <filesystem>
+#include <optional>
 
 #include "hw_interface/fpga_bridge.hpp"
 #include "emulator/emulator_dispatcher.hpp"
@@ -47,8 +49,11 @@ public:
     void start();
     void stop();
     float get_sampling_frequency() const;
-    hardware_sim_data_t get_hardware_sim_data(const nlohmann::json &specs);
+    hardware_sim_data_t get_hardware_sim_data(const nlohmann::json &specs, hw_sim_format format = hw_sim_format::text);
+    std::optional<hardware_sim_data_t> write_hardware_sim_data(const nlohmann::json &specs, const std::string &name, hw_sim_format format);
 private:
+    void prepare_hardware_sim(const nlohmann::json &specs);
+    void fill_hardware_sim_labels(hardware_sim_data_t &sim_data);
 
     void setup_interconnect_iv(const std::vector<fcore::deployed_program> &programs);
     void setup_inputs(std::vector<fcore::deployed_program> &programs);
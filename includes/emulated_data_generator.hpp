@@ -28,12 +28,12 @@
 
 class emulated_data_generator {
 public:
-    explicit emulated_data_generator(uint32_t size);
+    emulated_data_generator(uint32_t n_channels, uint32_t size);
     void set_data_file(std::string file);
     std::vector<std::vector<float>> get_data(std::vector<float> scaling_factors);
 private:
-    static constexpr int n_channels = 7;
-    std::array<std::vector<std::vector<float>>, n_channels> data;
+    uint32_t n_channels;
+    std::vector<std::vector<std::vector<float>>> data;
     int chunk_counter;
     bool external_emulator_data;
     uint32_t buffer_size;
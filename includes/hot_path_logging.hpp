@@ -0,0 +1,163 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef USCOPE_DRIVER_HOT_PATH_LOGGING_HPP
+#define USCOPE_DRIVER_HOT_PATH_LOGGING_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+#ifdef SPDLOG_FMT_EXTERNAL
+    #include <fmt/args.h>
+#else
+    #include <spdlog/fmt/bundled/args.h>
+#endif
+
+// Lowest level that is compiled into the hot path logging macros (using the SPDLOG_LEVEL_* values), anything below it
+// is removed by the preprocessor together with the evaluation of its arguments
+#ifndef USCOPE_HOT_LOG_LEVEL
+    #ifdef VERBOSE_LOGGING
+        #define USCOPE_HOT_LOG_LEVEL SPDLOG_LEVEL_TRACE
+    #else
+        #define USCOPE_HOT_LOG_LEVEL SPDLOG_LEVEL_INFO
+    #endif
+#endif
+
+#define HOT_LOG_IMPL(lvl, fmt_str, ...) \
+    do { if(spdlog::should_log(lvl)) hot_path_logger::log(lvl, fmt_str __VA_OPT__(,) __VA_ARGS__); } while(0)
+
+#if USCOPE_HOT_LOG_LEVEL <= SPDLOG_LEVEL_TRACE
+    #define HOT_LOG_TRACE(fmt_str, ...) HOT_LOG_IMPL(spdlog::level::trace, "" fmt_str __VA_OPT__(,) __VA_ARGS__)
+#else
+    #define HOT_LOG_TRACE(fmt_str, ...) (void)0
+#endif
+
+#if USCOPE_HOT_LOG_LEVEL <= SPDLOG_LEVEL_DEBUG
+    #define HOT_LOG_DEBUG(fmt_str, ...) HOT_LOG_IMPL(spdlog::level::debug, "" fmt_str __VA_OPT__(,) __VA_ARGS__)
+#else
+    #define HOT_LOG_DEBUG(fmt_str, ...) (void)0
+#endif
+
+#if USCOPE_HOT_LOG_LEVEL <= SPDLOG_LEVEL_INFO
+    #define HOT_LOG_INFO(fmt_str, ...) HOT_LOG_IMPL(spdlog::level::info, "" fmt_str __VA_OPT__(,) __VA_ARGS__)
+#else
+    #define HOT_LOG_INFO(fmt_str, ...) (void)0
+#endif
+
+
+struct hot_log_arg {
+    enum {unsigned_int, signed_int, floating} kind;
+    union {
+        uint64_t u;
+        int64_t i;
+        double f;
+    };
+};
+
+/// Log message captured in binary form, the format string must be a literal, as only its address is stored
+struct hot_log_record {
+    spdlog::level::level_enum level;
+    const char *format;
+    uint8_t n_args;
+    std::array<hot_log_arg, 4> args;
+};
+
+/// Bounded multi producer ring of log records, each slot carries a sequence number that tells producers and the
+/// consumer whether it is free or full, so no lock is needed on the logging side
+class hot_log_ring {
+public:
+    explicit hot_log_ring(size_t capacity);
+    bool try_push(const hot_log_record &r);
+    bool try_pop(hot_log_record &r);
+private:
+    struct slot {
+        std::atomic<size_t> sequence;
+        hot_log_record record;
+    };
+    std::vector<slot> slots;
+    size_t mask;
+    alignas(64) std::atomic<size_t> enqueue_pos = 0;
+    alignas(64) std::atomic<size_t> dequeue_pos = 0;
+};
+
+class hot_path_logger {
+public:
+    static void enable_async(size_t capacity);
+    static void disable_async();
+    static uint64_t get_dropped() {return dropped;}
+
+    // Producers register themselves in active_producers before looking at the ring, so that disable_async can wait for
+    // all the producers that might still hold the ring it retired before the formatting thread drains it and frees it
+    template<typename... Args>
+    static void log(spdlog::level::level_enum level, const char *format, Args... args) {
+        static_assert(sizeof...(Args) <= 4, "Hot path log messages can have at most 4 arguments");
+        active_producers.fetch_add(1);
+        if(auto *r = active_ring.load()){
+            hot_log_record record{level, format, sizeof...(Args), {make_arg(args)...}};
+            if(!r->try_push(record)) dropped++;
+            active_producers.fetch_sub(1, std::memory_order_release);
+        } else {
+            active_producers.fetch_sub(1, std::memory_order_release);
+            spdlog::log(level, fmt::runtime(format), args...);
+        }
+    }
+
+private:
+    template<typename T>
+    static hot_log_arg make_arg(T v) {
+        static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "Hot path log arguments must be numeric");
+        hot_log_arg a{};
+        if constexpr (std::is_floating_point_v<T>) {
+            a.kind = hot_log_arg::floating;
+            a.f = v;
+        } else if constexpr (std::is_enum_v<T>) {
+            a.kind = hot_log_arg::signed_int;
+            a.i = static_cast<int64_t>(v);
+        } else if constexpr (std::is_signed_v<T>) {
+            a.kind = hot_log_arg::signed_int;
+            a.i = v;
+        } else {
+            a.kind = hot_log_arg::unsigned_int;
+            a.u = v;
+        }
+        return a;
+    }
+
+    static void stop_async();
+    static void notify();
+    static void formatting_loop(hot_log_ring *r);
+    static void format_record(const hot_log_record &r);
+
+    static std::atomic<hot_log_ring *> active_ring;
+    static std::atomic<uint32_t> active_producers;
+    static std::atomic<bool> running;
+    static std::atomic<uint64_t> dropped;
+    static std::mutex config_mutex;
+    static std::unique_ptr<hot_log_ring> ring;
+    static std::thread formatting_thread;
+    static std::mutex wakeup_mutex;
+    static std::condition_variable wakeup;
+};
+
+#endif //USCOPE_DRIVER_HOT_PATH_LOGGING_HPP
@@ -16,21 +16,34 @@
 #ifndef USCOPE_DRIVER_BUS_ACCESSOR_HPP
 #define USCOPE_DRIVER_BUS_ACCESSOR_HPP
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <csignal>
-#include <fcntl.h>
-#include <sys/mman.h>
+#include <fstream>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <spdlog/spdlog.h>
 
-#include "hw_interface/interfaces_dictionary.hpp"
-
-#define ZYNQ_REGISTERS_BASE_ADDR 0x43c00000
-#define ZYNQ_FCORE_BASE_ADDR 0x83c00000
-#define ZYNQMP_REGISTERS_BASE_ADDR 0x400000000
-#define ZYNQMP_FCORE_BASE_ADDR 0x500000000
+#include "hot_path_logging.hpp"
 
+#include "hw_interface/interfaces_dictionary.hpp"
+#include "hw_interface/bus/bus_backend.hpp"
+#include "hw_interface/bus/mmap_bus_backend.hpp"
+#include "hw_interface/bus/simulated_bus_backend.hpp"
+#include "hw_interface/bus/null_bus_backend.hpp"
+#include "hw_interface/bus/recording_bus_backend.hpp"
+#include "hw_interface/bus/bus_trace.hpp"
+#include "hw_interface/bus/hw_sim_exporter.hpp"
+#include "hw_interface/bus/bus_stats.hpp"
+#include "hw_interface/bus/write_behind_queue.hpp"
 
-enum bus_access_type {control_plane_write, rom_plane_write, control_plane_read, rom_plane_read};
 
 struct bus_op{
     std::vector<uint64_t> address;
@@ -41,27 +54,115 @@ struct bus_op{
 class bus_accessor {
 public:
     bus_accessor();
-    void load_program(uint64_t address, const std::vector<uint32_t> program);
-    void write_register(const std::vector<uint64_t>& addresses, uint64_t data);
-    uint32_t read_register(const std::vector<uint64_t>& address);
+    explicit bus_accessor(std::shared_ptr<bus_backend> b);
+    ~bus_accessor();
+    void load_program(uint64_t address, const std::vector<uint32_t> &program);
+    void write_register(uint64_t address, uint32_t data);
+    void write_registers(std::span<const std::pair<uint64_t, uint32_t>> writes);
+    void write_proxied(uint64_t proxy_address, uint64_t target_address, uint32_t data);
+    uint32_t read_register(uint64_t address);
+    std::vector<uint32_t> read_registers(const std::vector<uint64_t>& addresses);
+    void sample_registers(const std::vector<uint64_t>& addresses, std::vector<uint32_t> &values);
+    uint32_t modify_register(uint64_t address, uint32_t mask, uint32_t value);
+    bool wait_for(uint64_t address, uint32_t mask, uint32_t expected, std::chrono::nanoseconds timeout, uint32_t &value);
+    static constexpr std::chrono::seconds max_wait_timeout{5};
+
+    void map_control_region(uint64_t address, uint64_t size);
+
+    std::vector<bus_op> get_operations() const;
+    std::pair<std::string, std::string> get_hardware_simulation_data(hw_sim_format format = hw_sim_format::text) const;
+    bool write_hardware_simulation_data(const std::string &rom_path, const std::string &control_path, hw_sim_format format) const;
+    void export_hardware_simulation_data(hw_sim_sink &rom, hw_sim_sink &control) const;
+
+    void disable_access();
+    void enable_access();
+    void clear_operations();
+
+    void set_backend(std::shared_ptr<bus_backend> b);
+    std::shared_ptr<bus_backend> get_backend() const {return backend;}
+    static std::shared_ptr<bus_backend> create_backend(const std::string &type);
+
+    bool start_trace(const std::string &path);
+    uint64_t stop_trace();
+    bool replay_trace(const std::string &path, bool original_timing, bus_replay_report &report);
 
-    uint64_t register_address_to_index(uint64_t address) const;
-    uint64_t fcore_address_to_index(uint64_t address) const;
+    void enable_shadow(bool enabled);
+    void declare_idempotent(uint64_t address);
+    void invalidate_shadow();
+    bool shadow_holds(uint64_t address, uint32_t data);
+    uint64_t get_elided_writes() const {return elided_writes;}
 
-    std::vector<bus_op> get_operations() {return operations;}
-    std::pair<std::string, std::string> get_hardware_simulation_data();
+    void enable_stats(bool enabled);
+    bool stats_enabled() const {return stats.is_enabled();}
+    void define_region(const std::string &name, uint64_t base, uint64_t size);
+    std::vector<bus_region_report> get_stats();
+    void reset_stats();
 
-    void disable_access() {previous_sink_mode = sink_mode; sink_mode = true;}
-    void enable_access() {sink_mode = previous_sink_mode;}
-    void clear_operations() {operations.clear();}
+    void enable_write_behind(bool enabled, size_t capacity = 4096);
+    bool write_behind_enabled() const {return write_behind.load(std::memory_order_relaxed);}
+    void flush() const;
+    std::unique_lock<std::mutex> quiesce();
 private:
-    bool previous_sink_mode = false;
-    uint64_t control_addr, core_addr;
+    class bus_lock;
+
+    void issue_write(bus_lock &lock, const queued_write &w);
+    void enqueue_write(const queued_write &w);
+    void bus_thread_loop();
+
+    struct logged_op {
+        bus_access_type type;
+        uint32_t n_addresses;
+        uint32_t n_data;
+        size_t payload_offset;
+    };
+
+    // Append an operation to the log, must be called with the bus lock held
+    template<std::ranges::sized_range A, std::ranges::sized_range D>
+    void log_operation(bus_access_type type, const A &addresses, const D &data){
+        if(operations_payload.size() + std::size(addresses) + std::size(data) > max_logged_words) {
+            if(!log_truncated) spdlog::warn("BUS OPERATIONS LOG: log full, further operations are not recorded");
+            log_truncated = true;
+            return;
+        }
+        operations.push_back({type, static_cast<uint32_t>(std::size(addresses)), static_cast<uint32_t>(std::size(data)), operations_payload.size()});
+        operations_payload.insert(operations_payload.end(), std::begin(addresses), std::end(addresses));
+        operations_payload.insert(operations_payload.end(), std::begin(data), std::end(data));
+    }
+    void log_operation(bus_access_type type, uint64_t address, uint64_t data){
+        log_operation(type, std::array<uint64_t, 1>{address}, std::array<uint64_t, 1>{data});
+    }
+
+    bool shadow_hit(uint64_t address, uint32_t data);
+    void export_operations(hw_sim_sink &rom, hw_sim_sink &control) const;
+
+    std::shared_ptr<bus_backend> backend;
+    std::shared_ptr<bus_backend> previous_backend;
+    std::shared_ptr<recording_bus_backend> trace_proxy;
+    std::shared_ptr<bus_trace_writer> trace_writer;
+    // The operations log only feeds the hardware simulation export, it is kept as a flat payload array plus fixed size
+    // descriptors, guarded by the bus lock. It is cleared at the start of each deployment and capped at
+    // max_logged_words, so that a long running session can not grow it without bound.
+    static constexpr size_t max_logged_words = 1<<22;
+    std::vector<logged_op> operations;
+    std::vector<uint64_t> operations_payload;
+    bool log_truncated = false;
+
+    bus_statistics stats;
+
+    // write behind mode: writes are queued by the callers and issued by a dedicated bus thread, the two counters let
+    // flush wait for all the writes enqueued before it to reach the bus
+    std::atomic<bool> write_behind = false;
+    std::atomic<bool> bus_thread_running = false;
+    std::unique_ptr<write_behind_queue> write_queue;
+    std::thread bus_thread;
+    std::atomic<uint64_t> enqueued_writes = 0;
+    std::atomic<uint64_t> completed_writes = 0;
+    std::atomic<uint32_t> doorbell = 0;
 
-    volatile uint32_t *registers;
-    volatile uint32_t *fCore;
-    static std::atomic<bool> sink_mode;
-    std::vector<bus_op> operations;
+    bool shadow_enabled = false;
+    uint64_t elided_writes = 0;
+    std::unordered_set<uint64_t> idempotent_registers;
+    std::unordered_map<uint64_t, uint32_t> shadow_registers;
 };
 
 
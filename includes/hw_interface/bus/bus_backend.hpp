@@ -0,0 +1,35 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef USCOPE_DRIVER_BUS_BACKEND_HPP
+#define USCOPE_DRIVER_BUS_BACKEND_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+enum bus_access_type {control_plane_write, rom_plane_write, control_plane_read, rom_plane_read};
+
+class bus_backend {
+public:
+    virtual ~bus_backend() = default;
+    virtual void write_register(uint64_t address, uint32_t value) = 0;
+    virtual uint32_t read_register(uint64_t address) = 0;
+    virtual void load_program(uint64_t address, const uint32_t *program, size_t size) = 0;
+    virtual void map_region(uint64_t address, uint64_t size) {}
+    virtual std::string get_name() const = 0;
+};
+
+
+#endif //USCOPE_DRIVER_BUS_BACKEND_HPP
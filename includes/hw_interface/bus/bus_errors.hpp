@@ -0,0 +1,26 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef USCOPE_DRIVER_BUS_ERRORS_HPP
+#define USCOPE_DRIVER_BUS_ERRORS_HPP
+
+#include <stdexcept>
+#include <string>
+
+class invalid_bus_access : public std::runtime_error {
+public:
+    explicit invalid_bus_access(const std::string &what) : std::runtime_error(what) {}
+};
+
+#endif //USCOPE_DRIVER_BUS_ERRORS_HPP
@@ -0,0 +1,89 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef USCOPE_DRIVER_BUS_STATS_HPP
+#define USCOPE_DRIVER_BUS_STATS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct bus_region_stats {
+    uint64_t reads = 0;
+    uint64_t writes = 0;
+    uint64_t bytes = 0;
+    uint64_t lock_hold_ns = 0;
+    uint64_t max_lock_wait_ns = 0;
+};
+
+struct bus_region_report {
+    std::string name;
+    uint64_t base;
+    uint64_t size;
+    bus_region_stats stats;
+};
+
+// Access counters for named regions of the bus, all methods except enable/is_enabled must be called with the bus lock
+// held. A region of size 0 extends up to the start of the next one.
+class bus_statistics {
+public:
+    void enable(bool e) {enabled.store(e, std::memory_order_relaxed);}
+    bool is_enabled() const {return enabled.load(std::memory_order_relaxed);}
+
+    void define_region(const std::string &name, uint64_t base, uint64_t size);
+    void count_access(uint64_t address, bool write, uint64_t n_accesses);
+    void count_lock(uint64_t address, std::chrono::nanoseconds wait, std::chrono::nanoseconds hold);
+    std::vector<bus_region_report> get_report() const;
+    void reset();
+private:
+    struct region {
+        std::string name;
+        uint64_t base;
+        uint64_t size;
+        bus_region_stats stats;
+    };
+    bus_region_stats &find_region(uint64_t address);
+
+    std::atomic<bool> enabled = false;
+    std::vector<region> regions;
+    size_t last_region = 0;
+    bus_region_stats unmapped;
+};
+
+class bus_accessor;
+
+// Periodically dumps the statistics of a bus accessor to the log
+class bus_stats_logger {
+public:
+    bus_stats_logger(std::shared_ptr<bus_accessor> ba, std::chrono::seconds interval);
+    ~bus_stats_logger();
+private:
+    void logging_loop();
+
+    std::shared_ptr<bus_accessor> busses;
+    std::chrono::seconds interval;
+    std::mutex stop_mutex;
+    std::condition_variable stop_cv;
+    bool stop_requested = false;
+    std::thread worker;
+};
+
+#endif //USCOPE_DRIVER_BUS_STATS_HPP
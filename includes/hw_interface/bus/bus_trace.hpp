@@ -0,0 +1,91 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef USCOPE_DRIVER_BUS_TRACE_HPP
+#define USCOPE_DRIVER_BUS_TRACE_HPP
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "hw_interface/bus/bus_backend.hpp"
+
+struct bus_transaction {
+    uint64_t timestamp;
+    uint64_t address;
+    uint32_t value;
+    bus_access_type type;
+};
+
+// On disk layout of a trace: an 8 byte header (magic + format version) followed by one fixed size record per transaction
+constexpr char bus_trace_magic[4] = {'U', 'B', 'T', 'R'};
+constexpr uint32_t bus_trace_version = 1;
+
+#pragma pack(push, 1)
+struct bus_trace_record {
+    uint64_t timestamp;
+    uint64_t address;
+    uint32_t value;
+    uint8_t type;
+};
+#pragma pack(pop)
+
+struct bus_replay_report {
+    uint64_t n_transactions = 0;
+    uint64_t trace_duration = 0;
+    uint64_t replay_duration = 0;
+    double throughput = 0;
+};
+
+class bus_trace_writer {
+public:
+    explicit bus_trace_writer(const std::string &path);
+    ~bus_trace_writer();
+    static bool is_valid_name(const std::string &name);
+    bool is_open() const {return output.is_open();}
+    void append(const bus_transaction &t);
+    void close();
+    uint64_t get_n_transactions() const {return n_transactions;}
+private:
+    std::ofstream output;
+    uint64_t n_transactions = 0;
+};
+
+class bus_trace_reader {
+public:
+    static bool load(const std::string &path, std::vector<bus_transaction> &trace);
+};
+
+class bus_trace_player {
+public:
+    explicit bus_trace_player(std::shared_ptr<bus_backend> target, std::mutex *bus_mutex = nullptr) :
+            target(std::move(target)), bus_mutex(bus_mutex) {}
+    bus_replay_report replay(const std::vector<bus_transaction> &trace, bool original_timing);
+private:
+    std::shared_ptr<bus_backend> target;
+    std::mutex *bus_mutex;
+};
+
+
+#endif //USCOPE_DRIVER_BUS_TRACE_HPP
@@ -0,0 +1,62 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+
+#ifndef USCOPE_DRIVER_HW_SIM_EXPORTER_HPP
+#define USCOPE_DRIVER_HW_SIM_EXPORTER_HPP
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <string>
+
+enum class hw_sim_format {
+    text,   // decimal "address:data" lines, the historical format
+    hex,    // fixed width "aaaaaaaaaaaaaaaa dddddddd" lines, as read by the RTL testbench
+    binary  // packed little endian hw_sim_record structures
+};
+
+#pragma pack(push, 1)
+struct hw_sim_record {
+    uint64_t address;
+    uint32_t data;
+};
+#pragma pack(pop)
+
+class hw_sim_sink {
+public:
+    hw_sim_sink(std::string &target, hw_sim_format format);
+    hw_sim_sink(std::ostream &target, hw_sim_format format);
+    hw_sim_sink(const hw_sim_sink &) = delete;
+    hw_sim_sink &operator=(const hw_sim_sink &) = delete;
+    ~hw_sim_sink();
+
+    void put(uint64_t address, uint64_t data);
+    void flush();
+
+    static size_t max_record_size(hw_sim_format format);
+private:
+    static constexpr size_t buffer_size = 64*1024;
+    static char *put_hex(char *out, uint64_t value, int digits);
+
+    hw_sim_format format;
+    std::string *string_target = nullptr;
+    std::ostream *stream_target = nullptr;
+    std::unique_ptr<char[]> buffer;
+    size_t fill = 0;
+};
+
+#endif //USCOPE_DRIVER_HW_SIM_EXPORTER_HPP
@@ -0,0 +1,78 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef USCOPE_DRIVER_MAPPED_BUS_HPP
+#define USCOPE_DRIVER_MAPPED_BUS_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include <spdlog/spdlog.h>
+
+#include "hw_interface/bus/bus_errors.hpp"
+
+/// Wait for all the outstanding writes to the mapped busses to complete
+inline void bus_write_barrier() {
+#if defined(__aarch64__) || defined(__arm__)
+    asm volatile("dsb sy" ::: "memory");
+#else
+    __sync_synchronize();
+#endif
+}
+
+class mapped_bus {
+public:
+    mapped_bus(const std::string &device, uint64_t base_address, uint64_t aperture_size, std::string bus_name);
+    ~mapped_bus();
+    mapped_bus(const mapped_bus&) = delete;
+    mapped_bus& operator=(const mapped_bus&) = delete;
+
+    bool map_region(uint64_t address, uint64_t size);
+    volatile uint32_t *translate(uint64_t address);
+    volatile uint32_t *translate(uint64_t address, uint64_t size);
+
+    uint64_t get_mapped_size() const;
+    size_t get_n_regions() const {return regions.size();}
+
+    static constexpr uint64_t window_size = 0x10000;
+private:
+    struct region {
+        uint64_t start;
+        uint64_t end;
+        volatile uint32_t *ptr;
+    };
+
+    const region *find_region(uint64_t address);
+    void check_aperture(uint64_t address, uint64_t size) const;
+
+    std::vector<region> regions;
+    size_t last_hit = 0;
+
+    std::string name;
+    int fd;
+    uint64_t base;
+    uint64_t aperture_end;
+    uint64_t page_size;
+};
+
+
+#endif //USCOPE_DRIVER_MAPPED_BUS_HPP
@@ -0,0 +1,48 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef USCOPE_DRIVER_MMAP_BUS_BACKEND_HPP
+#define USCOPE_DRIVER_MMAP_BUS_BACKEND_HPP
+
+#include <memory>
+#include <string>
+
+#include <spdlog/spdlog.h>
+
+#include "hw_interface/interfaces_dictionary.hpp"
+#include "hw_interface/bus/bus_backend.hpp"
+#include "hw_interface/bus/mapped_bus.hpp"
+
+#define ZYNQ_REGISTERS_BASE_ADDR 0x43c00000
+#define ZYNQ_FCORE_BASE_ADDR 0x83c00000
+#define ZYNQMP_REGISTERS_BASE_ADDR 0x400000000
+#define ZYNQMP_FCORE_BASE_ADDR 0x500000000
+
+class mmap_bus_backend : public bus_backend {
+public:
+    explicit mmap_bus_backend(const std::string &arch);
+    mmap_bus_backend(std::unique_ptr<mapped_bus> control, std::unique_ptr<mapped_bus> cores, bool batched_rom_load);
+    void write_register(uint64_t address, uint32_t value) override;
+    uint32_t read_register(uint64_t address) override;
+    void load_program(uint64_t address, const uint32_t *program, size_t size) override;
+    void map_region(uint64_t address, uint64_t size) override;
+    std::string get_name() const override {return "hardware";}
+private:
+    std::unique_ptr<mapped_bus> control_bus;
+    std::unique_ptr<mapped_bus> cores_bus;
+    bool batched_rom_load = false;
+};
+
+
+#endif //USCOPE_DRIVER_MMAP_BUS_BACKEND_HPP
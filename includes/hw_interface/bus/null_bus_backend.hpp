@@ -0,0 +1,29 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef USCOPE_DRIVER_NULL_BUS_BACKEND_HPP
+#define USCOPE_DRIVER_NULL_BUS_BACKEND_HPP
+
+#include "hw_interface/bus/bus_backend.hpp"
+
+class null_bus_backend : public bus_backend {
+public:
+    void write_register(uint64_t address, uint32_t value) override {}
+    uint32_t read_register(uint64_t address) override {return 0;}
+    void load_program(uint64_t address, const uint32_t *program, size_t size) override {}
+    std::string get_name() const override {return "null";}
+};
+
+
+#endif //USCOPE_DRIVER_NULL_BUS_BACKEND_HPP
@@ -0,0 +1,48 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+#ifndef USCOPE_DRIVER_RECORDING_BUS_BACKEND_HPP
+#define USCOPE_DRIVER_RECORDING_BUS_BACKEND_HPP
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "hw_interface/bus/bus_backend.hpp"
+#include "hw_interface/bus/bus_trace.hpp"
+
+class recording_bus_backend : public bus_backend {
+public:
+    explicit recording_bus_backend(std::shared_ptr<bus_backend> target);
+    void write_register(uint64_t address, uint32_t value) override;
+    uint32_t read_register(uint64_t address) override;
+    void load_program(uint64_t address, const uint32_t *program, size_t size) override;
+    void map_region(uint64_t address, uint64_t size) override {target->map_region(address, size);}
+    std::string get_name() const override {return "recording(" + target->get_name() + ")";}
+
+    std::shared_ptr<bus_backend> get_target() const {return target;}
+    const std::vector<bus_transaction> &get_transactions() const {return transactions;}
+    void clear_transactions() {transactions.clear();}
+    void set_trace_writer(std::shared_ptr<bus_trace_writer> w);
+private:
+    uint64_t now() const;
+    void record(const bus_transaction &t);
+
+    std::shared_ptr<bus_backend> target;
+    std::chrono::steady_clock::time_point epoch;
+    std::vector<bus_transaction> transactions;
+    std::shared_ptr<bus_trace_writer> writer;
+};
+
+
+#endif //USCOPE_DRIVER_RECORDING_BUS_BACKEND_HPP
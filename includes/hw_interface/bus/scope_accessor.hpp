@@ -17,18 +17,43 @@
 
 #include <spdlog/spdlog.h>
 #include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <poll.h>
+#include <algorithm>
+#include <chrono>
+#include <span>
+#include "hot_path_logging.hpp"
 #include "hw_interface/interfaces_dictionary.hpp"
 
 class scope_accessor {
 public:
-    scope_accessor();
+    explicit scope_accessor(uint32_t n_channels = default_n_channels, uint32_t buffer_size = default_buffer_size);
     ~scope_accessor();
-    static constexpr int n_channels = 6;
-    static constexpr int buffer_size = 1024;
-    std::array<uint64_t, n_channels*buffer_size> get_scope_data();
+    static constexpr uint32_t default_n_channels = 6;
+    static constexpr uint32_t default_buffer_size = 1024;
+    // ioctl commands of the scope data device. The buffer size query is only implemented by the mock module
+    // (IOCTL_GET_BUFFER_SIZE in mock_module.c), the hardware module rejects it and the configured geometry is used.
+    static constexpr unsigned long ioctl_new_data_available = 1;
+    static constexpr unsigned long ioctl_get_buffer_size = 2;
+    // upper bound of any wait for a new frame, so that a client can not park a thread indefinitely
+    static constexpr std::chrono::milliseconds max_wait_timeout{5000};
+
+    uint32_t get_n_channels() const {return n_channels;}
+    uint32_t get_buffer_size() const {return buffer_size;}
+    size_t get_frame_words() const {return static_cast<size_t>(n_channels)*buffer_size;}
+    size_t read_scope_data(std::span<uint64_t> buffer);
+
+    bool is_mapped() const {return mapped_data != nullptr;}
+    bool claim_mapped_frame();
+    bool new_data_available();
+    bool wait_for_data(std::chrono::milliseconds timeout);
+    std::span<const uint64_t> get_mapped_frame() const {return {mapped_data, get_frame_words()};}
 private:
-    static constexpr  int internal_buffer_size = n_channels*buffer_size;
+    uint32_t n_channels;
+    uint32_t buffer_size;
     volatile int fd_data;
+    const uint64_t *mapped_data = nullptr;
 };
 
 
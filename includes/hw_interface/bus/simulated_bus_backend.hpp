@@ -0,0 +1,43 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef USCOPE_DRIVER_SIMULATED_BUS_BACKEND_HPP
+#define USCOPE_DRIVER_SIMULATED_BUS_BACKEND_HPP
+
+#include <chrono>
+#include <unordered_map>
+
+#include "hw_interface/bus/bus_backend.hpp"
+
+class simulated_bus_backend : public bus_backend {
+public:
+    explicit simulated_bus_backend(std::chrono::nanoseconds latency = std::chrono::nanoseconds(0)) : access_latency(latency) {}
+    void write_register(uint64_t address, uint32_t value) override;
+    uint32_t read_register(uint64_t address) override;
+    void load_program(uint64_t address, const uint32_t *program, size_t size) override;
+    std::string get_name() const override {return "simulated";}
+
+    void set_latency(std::chrono::nanoseconds latency) {access_latency = latency;}
+    uint32_t peek_register(uint64_t address) const;
+    uint32_t peek_rom(uint64_t address) const;
+private:
+    void wait_access() const;
+
+    std::chrono::nanoseconds access_latency;
+    std::unordered_map<uint64_t, uint32_t> registers;
+    std::unordered_map<uint64_t, uint32_t> rom;
+};
+
+
+#endif //USCOPE_DRIVER_SIMULATED_BUS_BACKEND_HPP
@@ -0,0 +1,46 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef USCOPE_DRIVER_WRITE_BEHIND_QUEUE_HPP
+#define USCOPE_DRIVER_WRITE_BEHIND_QUEUE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+struct queued_write {
+    uint64_t address;
+    uint64_t proxy_address; // 0 for direct writes
+    uint32_t data;
+};
+
+/// Bounded multi producer, single consumer queue of register writes. Each slot carries a sequence number telling
+/// producers and the consumer whether it is free or full, so that enqueueing a write never takes a lock
+class write_behind_queue {
+public:
+    explicit write_behind_queue(size_t capacity);
+    bool try_push(const queued_write &w);
+    bool try_pop(queued_write &w);
+private:
+    struct slot {
+        std::atomic<size_t> sequence;
+        queued_write write;
+    };
+    std::vector<slot> slots;
+    size_t mask;
+    alignas(64) std::atomic<size_t> enqueue_pos = 0;
+    alignas(64) size_t dequeue_pos = 0;
+};
+
+#endif //USCOPE_DRIVER_WRITE_BEHIND_QUEUE_HPP
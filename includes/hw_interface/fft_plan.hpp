@@ -0,0 +1,60 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef USCOPE_DRIVER_FFT_PLAN_HPP
+#define USCOPE_DRIVER_FFT_PLAN_HPP
+
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// Precomputed forward complex FFT of a fixed length. Power of two lengths use an iterative radix-2 transform, any
+/// other length goes through Bluestein's algorithm on top of a power of two plan, so that every frame size can be
+/// transformed in O(n log n).
+class fft_plan {
+public:
+    explicit fft_plan(size_t n);
+    size_t size() const {return n;}
+    void forward(std::complex<float> *data);
+private:
+    void radix2(std::complex<float> *data);
+    void bluestein(std::complex<float> *data);
+
+    size_t n;
+    std::vector<uint32_t> bit_reversal;
+    std::vector<std::complex<float>> twiddles;
+
+    std::unique_ptr<fft_plan> inner;
+    std::vector<std::complex<float>> chirp;
+    std::vector<std::complex<float>> chirp_spectrum;
+    std::vector<std::complex<float>> scratch;
+};
+
+/// Forward FFT of real signals, returning the n/2+1 non redundant bins. Even lengths are transformed as a complex
+/// signal of half the length, with the even samples as real part and the odd ones as imaginary part.
+class real_fft_plan {
+public:
+    explicit real_fft_plan(size_t n);
+    size_t size() const {return n;}
+    size_t n_bins() const {return n/2 + 1;}
+    void forward(const float *input, std::complex<float> *output);
+private:
+    size_t n;
+    fft_plan plan;
+    std::vector<std::complex<float>> twiddles;
+    std::vector<std::complex<float>> buffer;
+};
+
+#endif //USCOPE_DRIVER_FFT_PLAN_HPP
@@ -25,6 +25,7 @@
 #include <chrono>
 #include <thread>
 #include <atomic>
+#include <span>
 
 #include <sys/ioctl.h>
 #include <sys/mman.h>
@@ -62,15 +63,33 @@ public:
     std::string get_hardware_version();
 
     void write_direct(uint64_t addr, uint32_t val);
+    void write_block(std::span<const std::pair<uint64_t, uint32_t>> writes);
     void write_proxied(uint64_t proxy_addr, uint32_t target_addr, uint32_t val);
     uint32_t read_direct(uint64_t address);
+    std::vector<uint32_t> read_snapshot(const std::vector<uint64_t> &addresses);
+    bool sample_registers(const std::vector<uint64_t> &addresses, std::vector<uint32_t> &values) const;
+    uint32_t modify_register(uint64_t address, uint32_t mask, uint32_t value);
+    bool wait_for(uint64_t address, uint32_t mask, uint32_t expected, std::chrono::nanoseconds timeout, uint32_t &value);
+
+    void declare_idempotent(uint64_t address) const {busses->declare_idempotent(address);}
+    bool register_holds(uint64_t address, uint32_t value) const {return fpga_loaded && busses->shadow_holds(address, value);}
+    void map_region(uint64_t address, uint64_t size) const {if(busses) busses->map_control_region(address, size);}
+    void define_bus_region(const std::string &name, uint64_t base, uint64_t size = 0) const {if(busses) busses->define_region(name, base, size);}
+    nlohmann::json get_bus_stats(bool enable, bool reset) const;
+    responses::response_code invalidate_register_cache() const;
+    responses::response_code flush_bus() const;
+
+    responses::response_code start_bus_trace(const std::string &name) const;
+    nlohmann::json stop_bus_trace() const;
+    nlohmann::json replay_bus_trace(const std::string &name, bool original_timing) const;
 
     uint32_t get_pl_clock( uint8_t clk_n);
     responses::response_code  set_pl_clock(uint8_t clk_n, uint32_t freq);
 
     std::vector<bus_op> get_bus_operations() const;
 
-    std::pair<std::string, std::string> get_hardware_simulation_data() const;
+    std::pair<std::string, std::string> get_hardware_simulation_data(hw_sim_format format = hw_sim_format::text) const;
+    bool write_hardware_simulation_data(const std::string &rom_path, const std::string &control_path, hw_sim_format format) const;
 
 
     void disable_bus_access() const {busses->disable_access(); busses->clear_operations();}
@@ -0,0 +1,58 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef USCOPE_DRIVER_FRAME_DECIMATOR_HPP
+#define USCOPE_DRIVER_FRAME_DECIMATOR_HPP
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+enum class decimation_mode {
+    none,
+    minmax,
+    lttb
+};
+
+/// Reduces a channel to at most a given number of points for display, while preserving its peaks.
+/// - minmax: the channel is split in max_points/2 buckets, and the minimum and maximum of each bucket are kept in
+///   order of occurrence, giving the exact envelope of the signal.
+/// - lttb: largest triangle three buckets, one point per bucket is kept, the one forming the largest triangle with the
+///   point kept in the previous bucket and the average of the next one, giving a visually faithful polyline.
+/// The index of each kept sample in the original channel is reported along with its value. Scratch buffers are reused
+/// between calls, so no allocation takes place in steady state.
+class frame_decimator {
+public:
+    static std::optional<decimation_mode> parse_mode(const std::string &mode);
+
+    size_t decimate(decimation_mode mode, std::span<const float> samples, size_t max_points);
+    std::span<const float> get_values() const {return {values.data(), n_points};}
+    std::span<const uint32_t> get_indices() const {return {indices.data(), n_points};}
+private:
+    void passthrough(std::span<const float> samples);
+    void minmax(std::span<const float> samples, size_t max_points);
+    void lttb(std::span<const float> samples, size_t max_points);
+    void push(std::span<const float> samples, size_t idx) {
+        values[n_points] = samples[idx];
+        indices[n_points++] = static_cast<uint32_t>(idx);
+    }
+
+    std::vector<float> values;
+    std::vector<uint32_t> indices;
+    size_t n_points = 0;
+};
+
+#endif //USCOPE_DRIVER_FRAME_DECIMATOR_HPP
@@ -0,0 +1,83 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef USCOPE_DRIVER_FRAME_DECODER_HPP
+#define USCOPE_DRIVER_FRAME_DECODER_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "hw_interface/scope_frame.hpp"
+
+enum class decode_kernel {
+    scalar,
+    sse2,
+    avx2,
+    neon
+};
+
+/// Signature of the decoding kernels: for each packed word the channel is stored in channels and the scaled sample
+/// (or the raw bits of floating point samples) in values. The scaling factors table has n_channels+1 entries, the
+/// last one being used for words with out of range channels.
+using decode_kernel_fn = void (*)(const uint64_t *words, size_t n_words, const float *scaling_factors,
+                                  uint32_t n_channels, uint32_t *channels, float *values);
+
+struct scatter_result {
+    size_t junk;     // words whose channel was equal to n_channels
+    size_t overflow; // samples past the capacity of their channel, written to its junk slot
+};
+
+/// Signature of the functions spreading the decoded samples to the per channel outputs, each output holds capacity
+/// samples followed by a junk slot
+using scatter_fn = scatter_result (*)(const uint32_t *channels, const float *values, size_t n_words, uint32_t n_channels,
+                                      size_t capacity, float *const *outputs, size_t *counts);
+
+/// Decodes the packed 64 bit words of a scope frame into per channel arrays of scaled samples.
+/// Each word carries the sample in its lower 32 bits, the channel in bits 32-47 and the channel metadata (sample
+/// width, signedness and floating point flag) in the upper 16 bits.
+class frame_decoder {
+public:
+    frame_decoder();
+    explicit frame_decoder(decode_kernel k);
+
+    static decode_kernel best_kernel();
+    static bool is_supported(decode_kernel k);
+    static std::string kernel_name(decode_kernel k);
+    decode_kernel get_kernel() const {return kernel;}
+
+    void decode(scope_frame &frame, const std::vector<float> &scaling_factors);
+
+    uint64_t get_junk_samples() const {return junk_samples;}
+    uint64_t get_overflow_samples() const {return overflow_samples;}
+private:
+    static scatter_fn select_scatter(uint32_t n_channels);
+
+    decode_kernel kernel;
+    decode_kernel_fn kernel_fn;
+    scatter_fn scatter = nullptr;
+    uint32_t scatter_channels = 0;
+
+    std::vector<float> sf_table;
+    std::vector<uint32_t> channels;
+    std::vector<float> values;
+    std::vector<size_t> counts;
+    std::vector<float *> outputs;
+    uint64_t junk_samples = 0;
+    uint64_t overflow_samples = 0;
+};
+
+#endif //USCOPE_DRIVER_FRAME_DECODER_HPP
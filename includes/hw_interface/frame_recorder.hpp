@@ -0,0 +1,116 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef USCOPE_DRIVER_FRAME_RECORDER_HPP
+#define USCOPE_DRIVER_FRAME_RECORDER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "hw_interface/scope_frame.hpp"
+
+/// Header preceding the packed words of each frame in a segment file
+struct recorded_frame_header {
+    uint32_t magic;
+    uint32_t n_words;
+    uint64_t sequence;
+    uint64_t timestamp_ns;
+};
+
+struct recorded_frame {
+    uint64_t sequence;
+    uint64_t timestamp_ns;
+    std::vector<uint64_t> words;
+};
+
+struct recording_info {
+    std::string name;
+    uint32_t n_segments = 0;
+    uint64_t n_frames = 0;
+    uint64_t size = 0;
+    uint64_t first_sequence = 0;
+    uint64_t last_sequence = 0;
+};
+
+/// Continuous capture of the raw scope frames to disk. Each recording is a directory of segment files, every segment is
+/// preallocated and memory mapped, then filled sequentially with header + words records until the next one does not
+/// fit, at which point the segment is truncated to its used size and a new one is started.
+/// Frames are handed to a writer thread through a bounded queue, so that the acquisition path only pays for a copy;
+/// when the writer can not keep up frames are dropped and counted instead of stalling the acquisition. The queue depth
+/// follows from a memory budget, so that large frames do not multiply into hundreds of megabytes of buffers.
+class frame_recorder {
+public:
+    static constexpr uint32_t frame_magic = 0x52465355; // "USFR"
+    static constexpr uint64_t default_segment_size = 64*1024*1024;
+    static constexpr size_t queue_budget = 16*1024*1024;
+    static constexpr size_t min_queue_depth = 2;
+    static constexpr size_t max_queue_depth = 64;
+
+    explicit frame_recorder(std::filesystem::path root);
+    ~frame_recorder();
+
+    bool start(const std::string &name, uint64_t segment_size, size_t frame_words);
+    void stop();
+    bool is_recording() const {return running.load(std::memory_order_relaxed);}
+    void record(const scope_frame &frame);
+
+    uint64_t get_recorded_frames() const {return recorded;}
+    uint64_t get_dropped_frames() const {return dropped;}
+    size_t get_queue_depth() const {return queue.size();}
+    std::string get_current_recording() const {return current_name;}
+
+    std::vector<recording_info> list() const;
+    std::vector<recorded_frame> fetch(const std::string &name, uint64_t first_sequence, uint64_t count) const;
+
+    static bool is_valid_name(const std::string &name);
+private:
+    struct queued_frame {
+        recorded_frame_header header;
+        std::vector<uint64_t> words;
+    };
+
+    void writer_loop();
+    bool open_segment();
+    void close_segment();
+    void append(const queued_frame &f);
+    static std::vector<std::filesystem::path> segments_of(const std::filesystem::path &dir);
+
+    std::filesystem::path root;
+    std::filesystem::path recording_dir;
+    std::string current_name;
+    uint64_t segment_size = default_segment_size;
+    uint32_t segment_index = 0;
+
+    int segment_fd = -1;
+    uint8_t *segment_map = nullptr;
+    uint64_t segment_used = 0;
+    uint64_t segment_synced = 0;
+
+    std::mutex producer_mtx;
+    std::vector<queued_frame> queue;
+    alignas(64) std::atomic<uint64_t> head = 0;
+    alignas(64) std::atomic<uint64_t> tail = 0;
+    std::atomic<uint64_t> doorbell = 0;
+    std::atomic<uint64_t> recorded = 0;
+    std::atomic<uint64_t> dropped = 0;
+    std::atomic<bool> running = false;
+    std::thread writer;
+};
+
+#endif //USCOPE_DRIVER_FRAME_RECORDER_HPP
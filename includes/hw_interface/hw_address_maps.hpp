@@ -18,45 +18,89 @@
 
 #include <cstdint>
 
-class scope_mux_am {
-public:
-    uint64_t ctrl = 0x0;
-    uint64_t ch_1 = 0x4;
-    uint64_t ch_2 = 0x8;
-    uint64_t ch_3 = 0xC;
-    uint64_t ch_4 = 0x10;
-    uint64_t ch_5 = 0x14;
-    uint64_t ch_6 = 0x18;
-};
-
-class scope_tb_am {
-public:
-    uint64_t ctrl = 0x0;
-    uint64_t period = 0x4;
-    uint64_t threshold = 0x8;
-};
-
-class scope_internal_am {
-public:
-    uint64_t trg_mode = 0x0;
-    uint64_t trg_lvl = 0x4;
-    uint64_t buf_low = 0x8;
-    uint64_t buf_high = 0xc;
-    uint64_t trg_src = 0x10;
-    uint64_t trg_point = 0x14;
-    uint64_t acq_mode = 0x18;
-    uint64_t trg_rearm_status = 0x1C;
-};
-
-
-class scope_address_map {
-public:
-    uint64_t mux_base = 0x0;
-    uint64_t tb_base = 0x100;
-    uint64_t internal_base = 0x200;
-    scope_mux_am mux;
-    scope_tb_am tb;
-    scope_internal_am scope_int;
+#include "hw_interface/register_map.hpp"
+
+struct scope_mux_block {
+    static constexpr uint64_t size = 0x100;
+    using ctrl = hw_register<0x0>;
+    // the number of scope channels is a runtime property, so the selectors span the rest of the block
+    using channel_selector = hw_register_array<0x4, (size - 0x4)/4>;
+};
+
+struct scope_timebase_block {
+    static constexpr uint64_t size = 0x100;
+    using ctrl = hw_register<0x0>;
+    using period = hw_register<0x4>;
+    using threshold = hw_register<0x8>;
+};
+
+struct scope_internal_block {
+    static constexpr uint64_t size = 0x100;
+    using trg_mode = hw_register<0x0>;
+    using trg_lvl = hw_register<0x4>;
+    using buf_low = hw_register<0x8>;
+    using buf_high = hw_register<0xc>;
+    using trg_src = hw_register<0x10>;
+    using trg_point = hw_register<0x14>;
+    using acq_mode = hw_register<0x18>;
+    using trg_rearm_status = hw_register<0x1C, register_access::read_only>;
+};
+
+struct scope_block {
+    static constexpr uint64_t size = 0x300;
+    using mux = hw_subblock<scope_mux_block, 0x0>;
+    using tb = hw_subblock<scope_timebase_block, 0x100>;
+    using internal = hw_subblock<scope_internal_block, 0x200>;
+};
+
+
+struct fcore_constant_engine_block {
+    static constexpr uint64_t size = 0x1C;
+    using const_lsb = hw_register<0x0>;
+    using const_hsb = hw_register<0x4>;
+    using const_dest = hw_register<0x8>;
+    using const_selector = hw_register<0xC>;
+    using clear_constant = hw_register<0x10>;
+    using active_channels = hw_register<0x14>;
+    using const_user = hw_register<0x18>;
+};
+
+struct square_wave_gen_block {
+    static constexpr uint64_t size = 0x28;
+    using active_channels = hw_register<0x0>;
+    using shape_selector = hw_register<0x4>;
+    using channel_selector = hw_register<0x8>;
+    using v_on = hw_register<0xc>;
+    using v_off = hw_register<0x10>;
+    using t_delay = hw_register<0x14>;
+    using t_on = hw_register<0x18>;
+    using period = hw_register<0x1c>;
+    using dest_out = hw_register<0x20>;
+    using user_out = hw_register<0x24>;
+};
+
+struct noise_generator_block {
+    static constexpr uint64_t size = 0x1000;
+    using active_outputs = hw_register<0x0>;
+    using output_destination = hw_register_array<0x4, 1023>;
+};
+
+
+struct hil_controller_block {
+    static constexpr uint64_t size = 0x1000;
+    using enable = hw_register<0x0>;
+    using core_divider = hw_register_array<0x4, 1023>;
+};
+
+struct hil_timebase_block {
+    static constexpr uint64_t size = 0x1000;
+    using period = hw_register<0x4>;
+    using core_shift = hw_register_array<0x8, 1022>;
+};
+
+struct hil_control_block {
+    static constexpr uint64_t size = 0x4;
+    using run = hw_register<0x0>;
 };
 
 #endif //USCOPE_DRIVER_HW_ADDRESS_MAPS_HPP
@@ -0,0 +1,73 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef USCOPE_DRIVER_REGISTER_MAP_HPP
+#define USCOPE_DRIVER_REGISTER_MAP_HPP
+
+#include <bit>
+#include <cstdint>
+#include <string>
+
+#include "hw_interface/bus/bus_errors.hpp"
+
+enum class register_access {read_only, write_only, read_write};
+
+/// Descriptor of a single 32 bit register at a fixed offset from the base of its block
+template<uint64_t Offset, register_access Access = register_access::read_write>
+struct hw_register {
+    static_assert(Offset % 4 == 0, "Register offsets must be word aligned");
+    static constexpr uint64_t offset = Offset;
+    static constexpr uint64_t end = Offset + 4;
+    static constexpr register_access access = Access;
+};
+
+/// Descriptor of an array of identical registers, the index is only known at runtime, so it is checked on access
+template<uint64_t Offset, uint64_t Length, register_access Access = register_access::read_write, uint64_t Stride = 4>
+struct hw_register_array {
+    static_assert(Offset % 4 == 0 && Stride % 4 == 0, "Register offsets must be word aligned");
+    static_assert(Length > 0, "Register arrays can not be empty");
+    static constexpr uint64_t offset = Offset;
+    static constexpr uint64_t length = Length;
+    static constexpr uint64_t end = Offset + Length*Stride;
+    static constexpr register_access access = Access;
+
+    template<uint64_t Index>
+    using at = hw_register<Offset + Index*Stride, Access>;
+
+    static constexpr uint64_t offset_of(uint64_t index) {
+        if(index >= Length) throw invalid_bus_access("Register array index " + std::to_string(index) + " out of range");
+        return Offset + index*Stride;
+    }
+};
+
+/// Descriptor of a bit field within a register
+template<uint32_t Mask>
+struct hw_field {
+    static_assert(Mask != 0, "Register fields can not be empty");
+    static constexpr uint32_t mask = Mask;
+    static constexpr uint32_t shift = std::countr_zero(Mask);
+
+    static constexpr uint32_t encode(uint32_t value) {return (value << shift) & mask;}
+    static constexpr uint32_t decode(uint32_t value) {return (value & mask) >> shift;}
+};
+
+/// Descriptor of a block nested at a fixed offset within another one
+template<typename Block, uint64_t Offset>
+struct hw_subblock {
+    using block = Block;
+    static constexpr uint64_t offset = Offset;
+    static constexpr uint64_t end = Offset + Block::size;
+};
+
+#endif //USCOPE_DRIVER_REGISTER_MAP_HPP
@@ -0,0 +1,76 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef USCOPE_DRIVER_REGISTER_SAMPLER_HPP
+#define USCOPE_DRIVER_REGISTER_SAMPLER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include "hw_interface/fpga_bridge.hpp"
+
+struct register_sample {
+    uint64_t timestamp;
+    uint32_t value;
+};
+
+class sample_ring {
+public:
+    explicit sample_ring(size_t depth) : samples(depth) {}
+    void push(const register_sample &s);
+    void copy_since(uint64_t timestamp, std::vector<register_sample> &out) const;
+private:
+    std::vector<register_sample> samples;
+    size_t head = 0;
+    size_t count = 0;
+};
+
+class register_sampler {
+public:
+    // bound on depth times number of registers, so that a single start can not exhaust the memory
+    static constexpr size_t max_samples = 1<<20;
+
+    explicit register_sampler(const fpga_bridge &hw) : hw(hw) {}
+    ~register_sampler();
+    void start(const std::vector<uint64_t> &addresses, uint32_t frequency, size_t depth);
+    void stop();
+    std::unique_lock<std::mutex> pause();
+    bool is_running() const {return running;}
+    nlohmann::json fetch(uint64_t since);
+    uint64_t get_overruns() const {return overruns;}
+private:
+    void sampling_loop();
+
+    fpga_bridge hw;
+    std::vector<uint64_t> addresses;
+    std::chrono::nanoseconds period{};
+
+    std::thread sampling_thread;
+    std::atomic<bool> running = false;
+    std::mutex pass_mutex;
+    std::atomic<uint64_t> overruns = 0;
+
+    std::mutex series_mutex;
+    std::vector<sample_ring> series;
+};
+
+
+#endif //USCOPE_DRIVER_REGISTER_SAMPLER_HPP
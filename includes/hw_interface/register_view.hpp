@@ -0,0 +1,109 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef USCOPE_DRIVER_REGISTER_VIEW_HPP
+#define USCOPE_DRIVER_REGISTER_VIEW_HPP
+
+#include <array>
+#include <cstdint>
+#include <utility>
+
+#include "hw_interface/register_map.hpp"
+#include "hw_interface/fpga_bridge.hpp"
+
+/// Typed accessor for the registers of a hardware block instance. All offsets are checked against the block size at
+/// compile time and resolved to constants, so accesses compile down to the same code as hand written address arithmetic.
+template<typename Block>
+class register_view {
+public:
+    register_view(fpga_bridge &hw, uint64_t base) : hw(hw), base(base) {}
+
+    uint64_t get_base() const {return base;}
+
+    template<typename Reg>
+    static constexpr uint64_t offset() {
+        static_assert(Reg::end <= Block::size, "Register outside of the block");
+        return Reg::offset;
+    }
+
+    template<typename Reg>
+    uint64_t address() const {return base + offset<Reg>();}
+
+    template<typename Array>
+    uint64_t address(uint64_t index) const {
+        static_assert(Array::end <= Block::size, "Register array outside of the block");
+        return base + Array::offset_of(index);
+    }
+
+    template<typename Reg>
+    void write(uint32_t value) const {
+        static_assert(Reg::access != register_access::read_only, "Write to a read only register");
+        hw.write_direct(address<Reg>(), value);
+    }
+
+    template<typename Array>
+    void write(uint64_t index, uint32_t value) const {
+        static_assert(Array::access != register_access::read_only, "Write to a read only register");
+        hw.write_direct(address<Array>(index), value);
+    }
+
+    /// Write a group of registers of the block in order, as a single bus transaction
+    /// \tparam Regs Registers to write, in the order the writes must be issued
+    /// \param values Values to write, one for each register
+    template<typename... Regs, typename... Values>
+    void write_block(Values... values) const {
+        static_assert(sizeof...(Regs) == sizeof...(Values), "A value is needed for each register of the block write");
+        static_assert(((Regs::access != register_access::read_only) && ...), "Write to a read only register");
+        const std::array<std::pair<uint64_t, uint32_t>, sizeof...(Regs)> writes{{{address<Regs>(), static_cast<uint32_t>(values)}...}};
+        hw.write_block(writes);
+    }
+
+    template<typename Reg>
+    uint32_t read() const {
+        static_assert(Reg::access != register_access::write_only, "Read from a write only register");
+        return hw.read_direct(address<Reg>());
+    }
+
+    template<typename Reg, typename Field>
+    uint32_t read_field() const {
+        return Field::decode(read<Reg>());
+    }
+
+    template<typename Reg, typename Field>
+    uint32_t write_field(uint32_t value) const {
+        static_assert(Reg::access == register_access::read_write, "Field updates need a read/write register");
+        return hw.modify_register(address<Reg>(), Field::mask, Field::encode(value));
+    }
+
+    template<typename Reg>
+    void declare_idempotent() const {
+        hw.declare_idempotent(address<Reg>());
+    }
+
+    template<typename Sub>
+    register_view<typename Sub::block> sub() const {
+        static_assert(Sub::end <= Block::size, "Sub-block outside of the block");
+        return register_view<typename Sub::block>(hw, base + Sub::offset);
+    }
+
+    void map() const {
+        hw.map_region(base, Block::size);
+    }
+
+private:
+    fpga_bridge &hw;
+    uint64_t base;
+};
+
+#endif //USCOPE_DRIVER_REGISTER_VIEW_HPP
@@ -0,0 +1,62 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef USCOPE_DRIVER_SCOPE_FRAME_HPP
+#define USCOPE_DRIVER_SCOPE_FRAME_HPP
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/// Storage for one scope acquisition: the packed words read from the DMA buffer and the decoded samples of each
+/// channel. The buffers are allocated at construction, so that a frame can be refilled in place any number of times
+/// without allocating. Each channel holds an even share of the words, plus a junk slot right past its capacity that
+/// absorbs the samples of a channel that shows up more often than that.
+class scope_frame {
+public:
+    scope_frame(uint32_t n_channels, size_t n_words) : n_channels(n_channels), raw(n_words),
+                                                       channel_capacity(n_channels == 0 ? 0 : n_words/n_channels),
+                                                       outputs(n_channels, std::vector<float>(channel_capacity + 1)),
+                                                       counts(n_channels, 0) {}
+
+    uint32_t get_n_channels() const {return n_channels;}
+    size_t get_capacity() const {return raw.size();}
+    size_t get_channel_capacity() const {return channel_capacity;}
+
+    std::span<uint64_t> raw_buffer() {return raw;}
+    std::span<const uint64_t> raw_words() const {return source;}
+    void set_valid_words(size_t n) {source = {raw.data(), n};}
+    /// Decode the next frame from words owned by someone else (i.e. the mapped DMA buffer) instead of the raw buffer,
+    /// the words must stay valid until the frame has been decoded, and raw_words() aliases them from then on
+    void set_source(std::span<const uint64_t> words) {source = words;}
+
+    float *channel_buffer(uint32_t channel) {return outputs[channel].data();}
+    void set_channel_size(uint32_t channel, size_t size) {counts[channel] = size;}
+    std::span<const float> channel(uint32_t channel) const {return {outputs[channel].data(), counts[channel]};}
+
+    /// Acquisition order of the frame, 0 for a frame that was never filled
+    uint64_t get_sequence() const {return sequence;}
+    void set_sequence(uint64_t s) {sequence = s;}
+
+private:
+    uint32_t n_channels;
+    std::vector<uint64_t> raw;
+    std::span<const uint64_t> source;
+    size_t channel_capacity;
+    std::vector<std::vector<float>> outputs;
+    std::vector<size_t> counts;
+    uint64_t sequence = 0;
+};
+
+#endif //USCOPE_DRIVER_SCOPE_FRAME_HPP
@@ -37,6 +37,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <mutex>
+#include <condition_variable>
 
 #include <spdlog/spdlog.h>
 
@@ -47,29 +48,20 @@
 #include "server_frontend/infrastructure/response.hpp"
 #include "hw_interface/fpga_bridge.hpp"
 #include "hw_interface/hw_address_maps.hpp"
+#include "hw_interface/register_view.hpp"
+#include "hw_interface/frame_decoder.hpp"
+#include "hw_interface/scope_frame.hpp"
+#include "hw_interface/triple_buffer.hpp"
+#include "hw_interface/frame_recorder.hpp"
+#include "hw_interface/frame_decimator.hpp"
+#include "hw_interface/software_trigger.hpp"
+#include "hw_interface/spectrum_analyzer.hpp"
 
 #include "bus/scope_accessor.hpp"
 
 #include "emulator/emulator_dispatcher.hpp"
 #include "deployment/deployment_utilities.hpp"
 
-#define GET_DATA(NUMBER) (NUMBER & 0xffffffff)
-#define GET_CHANNEL(NUMBER) ((NUMBER & 0x0000ffff00000000)>>32)
-#define GET_METADATA(NUMBER) ((NUMBER & 0xffff000000000000)>>48)
-
-static int32_t sign_extend(uint32_t value, uint32_t bits) {
-
-    int32_t result;
-
-    int x;      // sign extend this b-bit number to r
-    int r;      // resulting sign-extended number
-    int const mask = 1U << (bits - 1); // mask can be pre-computed if b is fixed
-
-    value = value & ((1U << bits) - 1);  // (Skip this if bits in x above position b are already zero.)
-    result = (value ^ mask) - mask;
-    return result;
-}
-
 struct acquisition_metadata{
     std::string mode;
     std::string trigger_mode;
@@ -80,14 +72,35 @@ struct acquisition_metadata{
     uint32_t prescaler;
 };
 
+struct read_data_options{
+    bool binary = false;
+    bool wait_new_data = false;
+    std::chrono::milliseconds timeout{1000};
+    decimation_mode decimation = decimation_mode::none;
+    uint32_t max_points = 0;
+    std::optional<spectrum_options> spectrum;
+};
+
 
 
 class scope_manager {
 
 public:
     scope_manager();
+    ~scope_manager();
     void set_accessors(const std::shared_ptr<bus_accessor> &ba, std::shared_ptr<scope_accessor> sa);
-    responses::response_code read_data(std::vector<nlohmann::json> &data_vector);
+    responses::response_code read_data(std::vector<nlohmann::json> &data_vector, const read_data_options &options = {});
+    bool acquire_frame();
+    const scope_frame &get_frame() const {return frames.front();}
+    void start_acquisition();
+    void stop_acquisition();
+    bool acquisition_running() const {return acquisition_thread.joinable();}
+    responses::response_code start_recording(const std::string &name, uint64_t segment_size);
+    responses::response_code stop_recording();
+    nlohmann::json get_recordings();
+    responses::response_code fetch_recording(const std::string &name, uint64_t first, uint64_t count, std::vector<nlohmann::json> &frames_out);
+    responses::response_code set_software_trigger(const std::optional<trigger_config> &cfg);
+    responses::response_code read_trigger_capture(nlohmann::json &capture_out, bool binary);
     responses::response_code set_scaling_factors(std::vector<float> &sf);
     responses::response_code set_channel_status(std::unordered_map<int, bool>status);
     std::string get_acquisition_status();
@@ -95,22 +108,45 @@ public:
     responses::response_code set_acquisition(const acquisition_metadata &data);
     void set_scope_address(uint64_t addr, uint64_t buffer_offset);
 private:
-
-    std::vector<std::vector<float>> shunt_data(
-            const std::array<uint64_t, configuration::n_channels*configuration::buffer_size>  &buffer_in
-    );
-    float scale_data(uint32_t raw_sample, unsigned int size, float scaling_factor, bool is_signed, bool is_float);
+    bool fill_frame(scope_frame &target, bool keep_raw);
+    bool fill_mapped_frame(scope_frame &target, bool keep_raw);
+    bool wait_published_frame(std::chrono::milliseconds timeout);
+    void acquisition_loop();
+    void run_trigger(const scope_frame &frame);
+    std::optional<software_trigger> stage_trigger(const trigger_config &cfg) const;
 
     uint64_t scope_base_address;
     bool first_load;
 
+    std::mutex sf_mtx;
     std::vector<float> scaling_factors;
-    int internal_buffer_size;
-    std::vector<uint32_t> data_holding_buffer;
+    std::atomic<uint32_t> sf_generation = 0;
+    std::vector<float> decoding_sf;
+    uint32_t decoding_sf_generation = 0;
     std::unordered_map<int, bool> channel_status;
 
+    register_view<scope_block> scope_registers() {return {hw, scope_base_address};}
+
     emulated_data_generator data_gen;
-    scope_address_map am;
+    frame_decoder decoder;
+    triple_buffer<scope_frame> frames;
+    uint64_t frame_sequence = 0;
+    frame_recorder recorder;
+    frame_decimator decimator;
+    spectrum_analyzer analyzer;
+
+    std::mutex trigger_mtx;
+    std::optional<trigger_config> requested_trigger;
+    std::optional<software_trigger> staged_trigger;
+    std::atomic<uint32_t> trigger_generation = 0;
+    uint32_t applied_trigger_generation = 0;
+    software_trigger trigger_engine;
+    triple_buffer<trigger_capture> captures;
+
+    std::thread acquisition_thread;
+    std::atomic<bool> acquisition_stop = false;
+    std::mutex publish_mtx;
+    std::condition_variable frame_published;
 
     std::shared_ptr<scope_accessor> scope_if;
     fpga_bridge hw;
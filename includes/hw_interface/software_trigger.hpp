@@ -0,0 +1,123 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef USCOPE_DRIVER_SOFTWARE_TRIGGER_HPP
+#define USCOPE_DRIVER_SOFTWARE_TRIGGER_HPP
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "hw_interface/scope_frame.hpp"
+
+enum class trigger_condition_type {
+    level,
+    edge,
+    window,
+    pulse_width,
+    runt
+};
+
+/// Meaning of the polarity for each condition type:
+/// - level: positive while above the level, negative while below it
+/// - edge: rising, falling or either edge through the level
+/// - window: positive when leaving the [level, upper] window, negative when entering it
+/// - pulse_width: width of the pulses above (positive) or below (negative) the level
+/// - runt: pulses crossing level but not upper (positive), or crossing upper but not level (negative)
+enum class trigger_polarity {
+    positive,
+    negative,
+    either
+};
+
+struct trigger_condition {
+    trigger_condition_type type = trigger_condition_type::edge;
+    trigger_polarity polarity = trigger_polarity::positive;
+    uint32_t channel = 0;
+    float level = 0;
+    float upper = 0;
+    uint64_t min_width = 0;
+    uint64_t max_width = std::numeric_limits<uint64_t>::max();
+};
+
+struct trigger_config {
+    bool combine_and = true;
+    std::vector<trigger_condition> conditions;
+    uint32_t pre_trigger = 0;
+    uint32_t post_trigger = 1;
+};
+
+/// Samples of all the channels around a trigger event, the trigger sample is at index pre_trigger of each channel
+struct trigger_capture {
+    uint64_t sequence = 0;
+    uint64_t trigger_position = 0;
+    uint32_t pre_trigger = 0;
+    std::vector<std::vector<float>> channels;
+};
+
+/// Trigger engine running over the continuous stream of decoded frames. The incoming samples are kept in a per channel
+/// history ring deep enough for the pre and post trigger windows, while each condition is evaluated a 64 sample word
+/// at a time: the threshold comparisons produce bitmaps through vector compares, edges and window transitions are
+/// plain bit operations on them, and the pulse width and runt state machines only visit the transitions. The
+/// bitmaps of the conditions are then combined with AND or OR, and the first set bit after the hold-off of the
+/// previous capture is the trigger point.
+class software_trigger {
+public:
+    static std::optional<trigger_condition_type> parse_type(const std::string &type);
+    static std::optional<trigger_polarity> parse_polarity(const std::string &polarity);
+
+    bool configure(const trigger_config &cfg, uint32_t n_channels, size_t frame_samples);
+    void disable() {enabled = false;}
+    bool is_enabled() const {return enabled;}
+    bool process(const scope_frame &frame, trigger_capture &out);
+    uint64_t get_trigger_count() const {return trigger_count;}
+    uint64_t get_oversized_frames() const {return oversized_frames;}
+private:
+    struct condition_state {
+        trigger_condition cfg;
+        bool prev_primary = false;
+        bool prev_secondary = false;
+        bool in_pulse = false;
+        uint64_t pulse_start = 0;
+        bool armed = false;
+        bool reached = false;
+        bool armed_negative = false;
+        bool reached_negative = false;
+        std::vector<uint64_t> primary;
+        std::vector<uint64_t> secondary;
+        std::vector<uint64_t> events;
+    };
+
+    void evaluate(condition_state &c, const float *samples, size_t n);
+    void emit(uint64_t trigger_position, trigger_capture &out);
+
+    bool enabled = false;
+    trigger_config config;
+    std::vector<condition_state> conditions;
+    std::vector<uint64_t> combined;
+
+    uint32_t n_channels = 0;
+    size_t frame_samples = 0;
+    uint64_t oversized_frames = 0;
+    std::vector<std::vector<float>> history;
+    size_t history_size = 0;
+    uint64_t stream_position = 0;
+    uint64_t holdoff = 0;
+    std::optional<uint64_t> pending;
+    uint64_t trigger_count = 0;
+};
+
+#endif //USCOPE_DRIVER_SOFTWARE_TRIGGER_HPP
@@ -0,0 +1,81 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef USCOPE_DRIVER_SPECTRUM_ANALYZER_HPP
+#define USCOPE_DRIVER_SPECTRUM_ANALYZER_HPP
+
+#include <complex>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "hw_interface/fft_plan.hpp"
+
+enum class spectrum_window {
+    rectangular,
+    hann,
+    hamming,
+    blackman,
+    flat_top
+};
+
+struct spectrum_options {
+    spectrum_window window = spectrum_window::hann;
+    bool magnitude = true;
+    bool phase = false;
+    bool db = false;
+    uint32_t averages = 1;
+};
+
+/// Single sided amplitude spectra of the scope channels. The magnitude is scaled by the coherent gain of the window,
+/// so that a sine of amplitude A shows up as a peak of height A, and can optionally be averaged over several frames
+/// (RMS averaging, linear up to the requested count, exponential afterwards). Each frame enters the average once, no
+/// matter how many times its spectrum is requested. The FFT plans and the window
+/// coefficients are cached per length, so steady state operation does not allocate.
+class spectrum_analyzer {
+public:
+    static std::optional<spectrum_window> parse_window(const std::string &window);
+
+    void compute(uint32_t channel, uint64_t sequence, std::span<const float> samples, const spectrum_options &options);
+    std::span<const float> get_magnitude() const {return magnitude;}
+    std::span<const float> get_phase() const {return phase;}
+private:
+    struct channel_average {
+        size_t length = 0;
+        spectrum_window window = spectrum_window::rectangular;
+        uint32_t averages = 0;
+        uint64_t count = 0;
+        uint64_t sequence = 0;
+        std::vector<float> power;
+    };
+
+    real_fft_plan &plan_for(size_t n);
+    const std::vector<float> &window_for(spectrum_window window, size_t n);
+
+    std::unordered_map<size_t, std::unique_ptr<real_fft_plan>> plans;
+    std::map<std::pair<spectrum_window, size_t>, std::vector<float>> windows;
+    std::vector<channel_average> averages;
+
+    std::vector<float> windowed;
+    std::vector<std::complex<float>> bins;
+    std::vector<float> magnitude;
+    std::vector<float> phase;
+};
+
+#endif //USCOPE_DRIVER_SPECTRUM_ANALYZER_HPP
@@ -0,0 +1,70 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#ifndef USCOPE_DRIVER_TRIPLE_BUFFER_HPP
+#define USCOPE_DRIVER_TRIPLE_BUFFER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/// Lock free single producer, single consumer triple buffer. The producer always owns a back slot it can fill at
+/// leisure, the consumer always owns a front slot it can read at leisure, and the third slot is exchanged atomically
+/// between the two. The consumer thus always gets the latest published value, intermediate values are dropped when the
+/// producer is faster than the consumer.
+template<typename T>
+class triple_buffer {
+public:
+    template<typename... Args>
+    explicit triple_buffer(const Args&... args) : slots{T(args...), T(args...), T(args...)} {}
+
+    /// Rebuild all the slots, only safe while neither the producer nor the consumer are active
+    template<typename... Args>
+    void reset(const Args&... args) {
+        for(auto &s:slots) s = T(args...);
+        back_idx = 0;
+        middle.store(1, std::memory_order_relaxed);
+        front_idx = 2;
+    }
+
+    /// \return The slot the producer is filling
+    T &back() {return slots[back_idx];}
+
+    /// Hand the back slot over to the consumer and take a free one in its place
+    void publish() {
+        back_idx = middle.exchange(back_idx | fresh_flag, std::memory_order_acq_rel) & index_mask;
+    }
+
+    /// Swap in the latest published slot, if the producer published one since the last call
+    /// \return true if the front slot now holds new data
+    bool update() {
+        if((middle.load(std::memory_order_relaxed) & fresh_flag) == 0) return false;
+        front_idx = middle.exchange(front_idx, std::memory_order_acq_rel) & index_mask;
+        return true;
+    }
+
+    /// \return The slot the consumer is reading
+    const T &front() const {return slots[front_idx];}
+
+private:
+    static constexpr uint8_t index_mask = 0x3;
+    static constexpr uint8_t fresh_flag = 0x4;
+
+    std::array<T, 3> slots;
+    uint8_t back_idx = 0;
+    std::atomic<uint8_t> middle = 1;
+    uint8_t front_idx = 2;
+};
+
+#endif //USCOPE_DRIVER_TRIPLE_BUFFER_HPP
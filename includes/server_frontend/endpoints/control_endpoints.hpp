@@ -17,12 +17,15 @@
 #ifndef USCOPE_DRIVER_CONTROL_ENDPOINTS_HPP
 #define USCOPE_DRIVER_CONTROL_ENDPOINTS_HPP
 
+#include <unordered_map>
+
 #include <nlohmann/json.hpp>
 #include <cppcodec/base64_rfc4648.hpp>
 
 #include "server_frontend/infrastructure/command.hpp"
 #include "server_frontend/infrastructure/response.hpp"
 #include "hw_interface/fpga_bridge.hpp"
+#include "hw_interface/register_sampler.hpp"
 
 class control_endpoints {
 public:
@@ -33,8 +36,20 @@ public:
 private:
     nlohmann::json process_single_write_register(nlohmann::json &arguments);
     nlohmann::json process_single_read_register(nlohmann::json &arguments);
+    nlohmann::json process_modify_register(nlohmann::json &arguments);
+    nlohmann::json process_wait_register(nlohmann::json &arguments);
+    nlohmann::json process_register_snapshot(nlohmann::json &arguments);
+    nlohmann::json process_define_register_set(nlohmann::json &arguments);
+    nlohmann::json process_sampler_start(nlohmann::json &arguments);
+    nlohmann::json process_sampler_stop();
+    nlohmann::json process_sampler_fetch(nlohmann::json &arguments);
     nlohmann::json process_load_bitstream(nlohmann::json &arguments);
     nlohmann::json process_apply_filter(nlohmann::json &arguments);
+    nlohmann::json process_invalidate_register_cache();
+    nlohmann::json process_bus_flush();
+    nlohmann::json process_bus_trace_start(nlohmann::json &arguments);
+    nlohmann::json process_bus_trace_replay(nlohmann::json &arguments);
+    nlohmann::json process_bus_stats(nlohmann::json &arguments);
 
     bool check_float_intness(double d){
         uint64_t rounded_addr = round(d);
@@ -48,6 +63,8 @@ private:
     };
 
     fpga_bridge hw;
+    std::unordered_map<std::string, std::vector<uint64_t>> register_sets;
+    std::shared_ptr<register_sampler> sampler;
 };
 
 
@@ -30,13 +30,19 @@ public:
     void set_accessor(const std::shared_ptr<bus_accessor> &ba, const std::shared_ptr<scope_accessor> &sa);
     nlohmann::json process_command(std::string command_string, nlohmann::json &arguments);
 private:
-    nlohmann::json process_read_data();
+    nlohmann::json process_read_data(nlohmann::json &arguments);
     nlohmann::json process_set_scaling_factors(nlohmann::json &arguments);
     nlohmann::json process_set_channel_status(nlohmann::json &arguments);
     nlohmann::json process_disable_dma(nlohmann::json &arguments);
     nlohmann::json process_get_acquisition_status();
     nlohmann::json process_set_scope_address(nlohmann::json &arguments);
     nlohmann::json process_set_acquisition(nlohmann::json &arguments);
+    nlohmann::json process_start_recording(nlohmann::json &arguments);
+    nlohmann::json process_stop_recording();
+    nlohmann::json process_list_recordings();
+    nlohmann::json process_fetch_recording(nlohmann::json &arguments);
+    nlohmann::json process_set_software_trigger(nlohmann::json &arguments);
+    nlohmann::json process_get_trigger_capture(nlohmann::json &arguments);
 
     scope_manager scope;
 };
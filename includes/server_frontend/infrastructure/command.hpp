@@ -26,11 +26,17 @@ namespace commands {
     static std::set<std::string> infrastructure_commands = {"null"};
 
     static std::set<std::string> control_commands = {"load_bitstream", "register_write", "register_read",
-                                              "apply_filter"};
+                                              "register_modify", "register_wait", "register_snapshot",
+                                              "define_register_set", "sampler_start", "sampler_stop", "sampler_fetch",
+                                              "apply_filter", "invalidate_register_cache",
+                                              "bus_trace_start", "bus_trace_stop", "bus_trace_replay", "bus_stats",
+                                              "bus_flush"};
 
     static std::set<std::string> scope_commands = {"read_data", "set_scaling_factors", "set_channel_status",
                                             "set_scaling_factors", "set_channel_status", "disable_scope_dma",
-                                             "get_acquisition_status", "set_acquisition", "set_scope_address"};
+                                             "get_acquisition_status", "set_acquisition", "set_scope_address",
+                                             "start_recording", "stop_recording", "list_recordings", "fetch_recording",
+                                             "set_software_trigger", "get_trigger_capture"};
 
     static std::set<std::string> core_commands = {"apply_program", "deploy_hil", "emulate_hil", "compile_program",
                                                   "hil_select_out", "hil_set_in", "hil_start", "hil_stop","hil_disassemble",
@@ -255,6 +261,396 @@ namespace commands {
         }
     )"_json;
 
+    static nlohmann::json  modify_register = R"(
+        {
+            "$schema": "https://json-schema.org/draft/2019-09/schema",
+            "title": "Modify register schema",
+            "properties": {
+                "address": {
+                    "type": "integer",
+                    "title": "Address of the register to modify"
+                },
+                "mask": {
+                    "type": "integer",
+                    "minimum": 0,
+                    "maximum": 4294967295,
+                    "title": "Bits of the register to update"
+                },
+                "value": {
+                    "type": "integer",
+                    "minimum": 0,
+                    "maximum": 4294967295,
+                    "title": "New value of the masked bits"
+                }
+            },
+            "required": [
+                "address",
+                "mask",
+                "value"
+            ],
+            "type": "object"
+        }
+    )"_json;
+
+    static nlohmann::json  wait_register = R"(
+        {
+            "$schema": "https://json-schema.org/draft/2019-09/schema",
+            "title": "Wait register schema",
+            "properties": {
+                "address": {
+                    "type": "integer",
+                    "title": "Address of the register to poll"
+                },
+                "mask": {
+                    "type": "integer",
+                    "minimum": 0,
+                    "maximum": 4294967295,
+                    "title": "Bits of the register to check"
+                },
+                "expected": {
+                    "type": "integer",
+                    "minimum": 0,
+                    "maximum": 4294967295,
+                    "title": "Expected value of the masked bits"
+                },
+                "timeout": {
+                    "type": "integer",
+                    "minimum": 0,
+                    "maximum": 5000000,
+                    "title": "Maximum wait time in microseconds, at most 5 seconds"
+                }
+            },
+            "required": [
+                "address",
+                "mask",
+                "expected",
+                "timeout"
+            ],
+            "type": "object"
+        }
+    )"_json;
+
+    static nlohmann::json  register_snapshot = R"(
+        {
+            "$schema": "https://json-schema.org/draft/2019-09/schema",
+            "title": "Register snapshot schema",
+            "oneOf": [
+                {
+                    "type": "array",
+                    "title": "Addresses of the registers to read",
+                    "items": {
+                        "type": "integer"
+                    }
+                },
+                {
+                    "type": "string",
+                    "title": "Name of a previously defined register set"
+                }
+            ]
+        }
+    )"_json;
+
+    static nlohmann::json  register_set = R"(
+        {
+            "$schema": "https://json-schema.org/draft/2019-09/schema",
+            "title": "Register set definition schema",
+            "properties": {
+                "name": {
+                    "type": "string",
+                    "title": "Name of the register set"
+                },
+                "addresses": {
+                    "type": "array",
+                    "title": "Addresses of the registers in the set",
+                    "items": {
+                        "type": "integer"
+                    }
+                }
+            },
+            "required": [
+                "name",
+                "addresses"
+            ],
+            "type": "object"
+        }
+    )"_json;
+
+    static nlohmann::json  sampler_start = R"(
+        {
+            "$schema": "https://json-schema.org/draft/2019-09/schema",
+            "title": "Register sampler start schema",
+            "properties": {
+                "addresses": {
+                    "type": "array",
+                    "title": "Addresses of the registers to sample",
+                    "items": {
+                        "type": "integer"
+                    },
+                    "minItems": 1,
+                    "maxItems": 256
+                },
+                "frequency": {
+                    "type": "integer",
+                    "minimum": 1,
+                    "maximum": 10000,
+                    "title": "Sampling frequency in Hz"
+                },
+                "depth": {
+                    "type": "integer",
+                    "minimum": 1,
+                    "maximum": 1048576,
+                    "title": "Number of samples retained for each register, at most 1048576 across all the registers"
+                }
+            },
+            "required": [
+                "addresses",
+                "frequency"
+            ],
+            "type": "object"
+        }
+    )"_json;
+
+    static nlohmann::json  bus_stats = R"(
+        {
+            "$schema": "https://json-schema.org/draft/2019-09/schema",
+            "title": "Bus statistics schema",
+            "properties": {
+                "enable": {
+                    "type": "boolean",
+                    "title": "Collect the statistics from now on"
+                },
+                "reset": {
+                    "type": "boolean",
+                    "title": "Clear the counters after reading them"
+                }
+            },
+            "required": [
+                "enable"
+            ],
+            "type": "object"
+        }
+    )"_json;
+
+    static nlohmann::json  replay_bus_trace = R"(
+        {
+            "$schema": "https://json-schema.org/draft/2019-09/schema",
+            "title": "Bus trace replay schema",
+            "properties": {
+                "name": {
+                    "type": "string",
+                    "title": "Name of the trace file to replay, relative to the traces directory"
+                },
+                "original_timing": {
+                    "type": "boolean",
+                    "title": "Reproduce the timing of the original trace instead of replaying it as fast as possible"
+                }
+            },
+            "required": [
+                "name",
+                "original_timing"
+            ],
+            "type": "object"
+        }
+    )"_json;
+
+    static nlohmann::json  read_data = R"(
+        {
+            "$schema": "https://json-schema.org/draft/2019-09/schema",
+            "title": "Read data schema",
+            "properties": {
+                "binary": {
+                    "type": "boolean",
+                    "title": "Pack the samples of each channel as a binary blob of 32 bit floats"
+                },
+                "wait": {
+                    "type": "boolean",
+                    "title": "Block until the scope signals a new frame"
+                },
+                "timeout": {
+                    "type": "integer",
+                    "minimum": 0,
+                    "maximum": 5000,
+                    "title": "Maximum wait time in milliseconds, at most 5 seconds"
+                },
+                "decimation": {
+                    "type": "object",
+                    "title": "Reduce each channel to at most a given number of points",
+                    "properties": {
+                        "mode": {
+                            "type": "string",
+                            "enum": ["none", "minmax", "lttb"],
+                            "title": "Decimation algorithm"
+                        },
+                        "points": {
+                            "type": "integer",
+                            "minimum": 3,
+                            "title": "Maximum number of points per channel"
+                        }
+                    },
+                    "required": [
+                        "mode",
+                        "points"
+                    ]
+                },
+                "spectrum": {
+                    "type": "object",
+                    "title": "Return the spectrum of each channel instead of its samples",
+                    "properties": {
+                        "window": {
+                            "type": "string",
+                            "enum": ["rectangular", "hann", "hamming", "blackman", "flat_top"],
+                            "title": "Window applied to the frame"
+                        },
+                        "output": {
+                            "type": "string",
+                            "enum": ["magnitude", "phase", "both"],
+                            "title": "Spectra returned for each channel"
+                        },
+                        "db": {
+                            "type": "boolean",
+                            "title": "Magnitude in dB instead of linear units"
+                        },
+                        "averages": {
+                            "type": "integer",
+                            "minimum": 1,
+                            "maximum": 1024,
+                            "title": "Number of frames the magnitude is averaged over"
+                        }
+                    }
+                }
+            },
+            "type": "object"
+        }
+    )"_json;
+
+    static nlohmann::json  start_recording = R"(
+        {
+            "$schema": "https://json-schema.org/draft/2019-09/schema",
+            "title": "Start recording schema",
+            "properties": {
+                "name": {
+                    "type": "string",
+                    "pattern": "^[A-Za-z0-9_.-]+$",
+                    "title": "Name of the recording"
+                },
+                "segment_size": {
+                    "type": "integer",
+                    "minimum": 4096,
+                    "title": "Size of each segment file in bytes"
+                }
+            },
+            "required": [
+                "name"
+            ],
+            "type": "object"
+        }
+    )"_json;
+
+    static nlohmann::json  fetch_recording = R"(
+        {
+            "$schema": "https://json-schema.org/draft/2019-09/schema",
+            "title": "Fetch recording schema",
+            "properties": {
+                "name": {
+                    "type": "string",
+                    "title": "Name of the recording"
+                },
+                "first": {
+                    "type": "integer",
+                    "minimum": 0,
+                    "title": "Sequence number of the first frame to fetch"
+                },
+                "count": {
+                    "type": "integer",
+                    "minimum": 1,
+                    "maximum": 1024,
+                    "title": "Maximum number of frames to fetch"
+                }
+            },
+            "required": [
+                "name"
+            ],
+            "type": "object"
+        }
+    )"_json;
+
+    static nlohmann::json  software_trigger = R"(
+        {
+            "$schema": "https://json-schema.org/draft/2019-09/schema",
+            "title": "Software trigger schema",
+            "properties": {
+                "enabled": {
+                    "type": "boolean",
+                    "title": "Run the software trigger on the acquired frames"
+                },
+                "combine": {
+                    "type": "string",
+                    "enum": ["and", "or"],
+                    "title": "How the conditions are combined"
+                },
+                "pre_trigger": {
+                    "type": "integer",
+                    "minimum": 0,
+                    "maximum": 16384,
+                    "title": "Samples captured before the trigger point"
+                },
+                "post_trigger": {
+                    "type": "integer",
+                    "minimum": 1,
+                    "maximum": 16384,
+                    "title": "Samples captured from the trigger point onwards"
+                },
+                "conditions": {
+                    "type": "array",
+                    "minItems": 1,
+                    "items": {
+                        "type": "object",
+                        "properties": {
+                            "type": {
+                                "type": "string",
+                                "enum": ["level", "edge", "window", "pulse_width", "runt"]
+                            },
+                            "channel": {
+                                "type": "integer",
+                                "minimum": 0
+                            },
+                            "polarity": {
+                                "type": "string",
+                                "enum": ["positive", "negative", "rising", "falling", "either"]
+                            },
+                            "level": {
+                                "type": "number",
+                                "title": "Threshold, lower one for window and runt conditions"
+                            },
+                            "upper": {
+                                "type": "number",
+                                "title": "Upper threshold of window and runt conditions"
+                            },
+                            "min_width": {
+                                "type": "integer",
+                                "minimum": 0,
+                                "title": "Minimum pulse width in samples"
+                            },
+                            "max_width": {
+                                "type": "integer",
+                                "minimum": 0,
+                                "title": "Maximum pulse width in samples"
+                            }
+                        },
+                        "required": [
+                            "type",
+                            "channel"
+                        ]
+                    }
+                }
+            },
+            "required": [
+                "enabled"
+            ],
+            "type": "object"
+        }
+    )"_json;
+
     static bool validate_schema(const nlohmann::json &cmd, nlohmann::json &schema, std::string &error){
         schema_validator sv(schema);
         return sv.validate(cmd, error);
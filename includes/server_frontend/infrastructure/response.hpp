@@ -32,7 +32,10 @@ namespace responses {
         deployment_error= 8,
         hil_bus_conflict_warning = 9,
         driver_file_not_found = 10,
-        driver_write_failed = 11
+        driver_write_failed = 11,
+        bus_access_error = 12,
+        wait_timeout = 13,
+        no_new_data = 14
     } response_code;
 
     template<typename response_code>
@@ -26,6 +26,7 @@
 #define BITSTREAM_SIZE  44549344>>3
 
 #define IOCTL_NEW_DATA_AVAILABLE 1
+#define IOCTL_GET_BUFFER_SIZE 2
 
 
 
@@ -122,8 +123,13 @@ static __poll_t ucube_lkm_poll(struct file *flip , struct poll_table_struct * po
 
 
 static int ucube_lkm_mmap(struct file *filp, struct vm_area_struct *vma){
-
+    int minor = MINOR(filp->f_inode->i_rdev);
     pr_info("%s: In mmap\n", __func__);
+    if(minor == 0){
+        if (vma->vm_end - vma->vm_start > PAGE_ALIGN(KERNEL_BUFFER_SIZE))
+            return -EINVAL;
+        return remap_vmalloc_range(vma, dev_data->read_data_buffer, 0);
+    }
     vma->vm_ops = &mock_vm_ops;
     return 0;
 }
@@ -138,6 +144,9 @@ static long ucube_lkm_ioctl(struct file *filp, unsigned int cmd, unsigned long a
         case IOCTL_NEW_DATA_AVAILABLE:
             return dev_data->new_data_available;
             break;
+        case IOCTL_GET_BUFFER_SIZE:
+            return KERNEL_BUFFER_SIZE;
+            break;
         default:
             return -EINVAL;
             break;
@@ -196,6 +205,7 @@ static ssize_t ucube_lkm_write(struct file *flip, const char *buffer, size_t len
 
     	if (copy_from_user(dev_data->read_data_buffer, buffer, to_copy))
         	return -EFAULT;
+        dev_data->new_data_available = 1;
 
     	return to_copy;
 	}else if(minor ==3){
@@ -303,7 +313,7 @@ static int __init ucube_lkm_init(void) {
 	}
 
     /*SETUP AND ALLOCATE DMA BUFFER*/
-    dev_data->read_data_buffer = vmalloc(KERNEL_BUFFER_SIZE);
+    dev_data->read_data_buffer = vmalloc_user(PAGE_ALIGN(KERNEL_BUFFER_SIZE));
 	bitstream_buffer = vmalloc(BITSTREAM_SIZE);
     pr_warn("%s: Allocated dma buffer at: %llu\n", __func__, dev_data->physaddr);;
 
@@ -17,13 +17,34 @@
 #include "deployment/deployer_base.hpp"
 
 void deployer_base::write_register(uint64_t addr, uint32_t val) {
-    spdlog::info("write 0x{0:x} to address {1:x}", val, addr);
-    nlohmann::json write;
-    write["type"] = "direct";
-    write["address"] = addr;
-    write["value"] = val;
+    HOT_LOG_INFO("write 0x{0:x} to address {1:x}", val, addr);
+    hw.write_direct(addr, val);
+}
+
+/// Map the control plane blocks named in the logic layout, cores are mapped on demand as they get deployed
+void deployer_base::map_layout_regions() {
+    for(auto block_base:{
+        addresses.bases.controller,
+        addresses.bases.hil_control,
+        addresses.bases.scope_mux,
+        addresses.bases.noise_generator,
+        addresses.bases.waveform_generator
+    }){
+        if(block_base != 0) hw.map_region(block_base, mapped_bus::window_size);
+    }
 
-    hw.single_write_register(write);
+    for(auto &[name, base]:std::initializer_list<std::pair<const char *, uint64_t>>{
+        {"cores_rom", addresses.bases.cores_rom},
+        {"cores_control", addresses.bases.cores_control},
+        {"cores_inputs", addresses.bases.cores_inputs},
+        {"controller", addresses.bases.controller},
+        {"hil_control", addresses.bases.hil_control},
+        {"scope_mux", addresses.bases.scope_mux},
+        {"noise_generator", addresses.bases.noise_generator},
+        {"waveform_generator", addresses.bases.waveform_generator}
+    }){
+        if(base != 0) hw.define_bus_region(name, base);
+    }
 }
 
 void deployer_base::load_core(uint64_t address, const std::vector<uint32_t> &program) {
@@ -40,6 +61,7 @@ uint16_t deployer_base::setup_output_dma(uint64_t address, const std::string &co
             current_io++;
         }
     }
+    hw.declare_idempotent(address);
     write_register(address, current_io);
     spdlog::info("------------------------------------------------------------------");
     return current_io;
@@ -69,6 +91,7 @@ void deployer_base::setup_output_entry(const fcore::deployer_interconnect_slot &
     uint64_t mapping_address = dma_address + +3*4 + io_progressive*4;
     spdlog::info("map core io address: ({0},{1}) to hil bus address: ({2},{3})",
                  e.source_io_address,e.source_channel, e.destination_bus_address, e.destination_channel);
+    hw.declare_idempotent(mapping_address);
     write_register(mapping_address, mapping);
 
     auto n_dma_channels = 16;
@@ -91,6 +114,7 @@ void deployer_base::setup_output_entry(const fcore::deployer_interconnect_slot &
         }
     }
 
+    hw.declare_idempotent(metadata_address);
     if(e.metadata.type == fcore::type_float){
         write_register(metadata_address, get_metadata_value(
                 32,
@@ -194,20 +218,24 @@ void deployer_base::setup_input(
             input_path = core_name + "." + in.name;
         }
 
+        register_view<fcore_constant_engine_block> engine(hw, metadata.const_ip_addr.first);
         inputs_labels[input_path] = {
-            metadata.const_ip_addr.first + fcore_constant_engine.const_lsb,
+            engine.address<fcore_constant_engine_block::const_lsb>(),
             metadata.dest,
             metadata.const_ip_addr.second,
         };
 
-        write_register(metadata.const_ip_addr.first + fcore_constant_engine.const_selector, metadata.const_ip_addr.second);
-        write_register( metadata.const_ip_addr.first + fcore_constant_engine.const_dest, metadata.dest);
-        write_register( metadata.const_ip_addr.first + fcore_constant_engine.const_lsb, input_value);
+        engine.write_block<
+            fcore_constant_engine_block::const_selector,
+            fcore_constant_engine_block::const_dest,
+            fcore_constant_engine_block::const_lsb
+        >(metadata.const_ip_addr.second, metadata.dest, input_value);
 
         inputs.push_back(metadata);
     } else if(in.source_type == fcore::random_input) {
         uint32_t address =in.address[0] + (target_channel<<16);
-        write_register( const_ip_address + (active_random_inputs+1)*4, address);
+        register_view<noise_generator_block> noise_gen(hw, const_ip_address);
+        noise_gen.write<noise_generator_block::output_destination>(active_random_inputs, address);
         active_random_inputs++;
 
         if(is_multichannel){
@@ -234,9 +262,12 @@ void deployer_base::update_input_value(const std::string &core_name,  const std:
         if(in.name == name && in.core == core_name && in.channel == channel){
             uint32_t value =static_cast<uint32_t>(raw_value);
             if(in.is_float) value = float_to_uint32(static_cast<float>(raw_value));
-            write_register(in.const_ip_addr.first + fcore_constant_engine.const_selector, in.const_ip_addr.second);
-            write_register( in.const_ip_addr.first + fcore_constant_engine.const_dest, in.dest);
-            write_register( in.const_ip_addr.first + fcore_constant_engine.const_lsb, value);
+            register_view<fcore_constant_engine_block> engine(hw, in.const_ip_addr.first);
+            engine.write_block<
+                fcore_constant_engine_block::const_selector,
+                fcore_constant_engine_block::const_dest,
+                fcore_constant_engine_block::const_lsb
+            >(in.const_ip_addr.second, in.dest, value);
             spdlog::info("HIL SET INPUT: set value {0} for input at address {1}, on core {2}", raw_value, in.dest, core_identifier);
         }
     }
@@ -247,17 +278,31 @@ void deployer_base::setup_waveform(const uint64_t address, const fcore::square_w
     uint64_t period = p.period[channel]*hil_clock_frequency;
     uint64_t t_on = p.t_on[channel]*hil_clock_frequency;
     uint64_t t_delay = p.t_delay[channel]*hil_clock_frequency;
-    write_register(address + square_wave_gen.channel_selector, active_waveforms);
-    write_register(address +square_wave_gen.v_on, float_to_uint32(p.v_on[channel]));
-    write_register(address +square_wave_gen.v_off, float_to_uint32(p.v_off[channel]));
-    write_register(address +square_wave_gen.t_delay, t_delay);
-    write_register(address +square_wave_gen.t_on, t_on);
-    write_register(address +square_wave_gen.period, period);
-    write_register(address +square_wave_gen.dest_out, dest);
-    write_register(address + square_wave_gen.shape_selector, 0);
-    write_register(address +square_wave_gen.user_out, get_metadata_value(32,true,true));
+    register_view<square_wave_gen_block> gen(hw, address);
+    gen.write_block<
+        square_wave_gen_block::channel_selector,
+        square_wave_gen_block::v_on,
+        square_wave_gen_block::v_off,
+        square_wave_gen_block::t_delay,
+        square_wave_gen_block::t_on,
+        square_wave_gen_block::period,
+        square_wave_gen_block::dest_out,
+        square_wave_gen_block::shape_selector,
+        square_wave_gen_block::user_out,
+        square_wave_gen_block::active_channels
+    >(
+        active_waveforms,
+        float_to_uint32(p.v_on[channel]),
+        float_to_uint32(p.v_off[channel]),
+        t_delay,
+        t_on,
+        period,
+        dest,
+        0,
+        get_metadata_value(32,true,true),
+        active_waveforms + 1
+    );
     active_waveforms++;
-    write_register(address + square_wave_gen.active_channels,  active_waveforms);
 }
 
 void deployer_base::setup_waveform(const uint64_t address, const fcore::sine_wave_parameters &p, uint32_t channel) {
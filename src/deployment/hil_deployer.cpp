@@ -113,21 +113,26 @@ void hil_deployer::setup_sequencer(uint16_t n_cores, std::vector<uint32_t> divis
     spdlog::info("------------------------------------------------------------------");
 
 
+    register_view<hil_controller_block> controller(hw, this->addresses.bases.controller + this->addresses.offsets.controller);
+    register_view<hil_timebase_block> timebase(hw, this->addresses.bases.controller + this->addresses.offsets.hil_tb);
+
     std::bitset<32> enable;
+    std::vector<std::pair<uint64_t, uint32_t>> core_setup;
     for(int i = 0; i<n_cores; i++){
         enable[i] = true;
-        this->write_register(this->addresses.bases.controller + this->addresses.offsets.controller + 0x4 + 4 * i, divisors[i]-1);
-        this->write_register(this->addresses.bases.controller + this->addresses.offsets.hil_tb + 8 + 4*i, shifts[i]);
+        core_setup.emplace_back(controller.address<hil_controller_block::core_divider>(i), divisors[i]-1);
+        core_setup.emplace_back(timebase.address<hil_timebase_block::core_shift>(i), shifts[i]);
     }
+    hw.write_block(core_setup);
 
     if(timebase_frequency == 0) {
-        this->write_register(this->addresses.bases.controller + this->addresses.offsets.hil_tb + 4, min_timebase);
+        timebase.write<hil_timebase_block::period>(min_timebase);
     } else {
-        this->write_register(this->addresses.bases.controller + this->addresses.offsets.hil_tb + 4, hil_clock_frequency/timebase_frequency);
+        timebase.write<hil_timebase_block::period>(hil_clock_frequency/timebase_frequency);
     }
 
 
-    this->write_register(this->addresses.bases.controller + this->addresses.offsets.controller, enable.to_ulong());
+    controller.write<hil_controller_block::enable>(enable.to_ulong());
 
 
     spdlog::info("------------------------------------------------------------------");
@@ -179,7 +184,9 @@ void hil_deployer::select_output(uint32_t channel, const output_specs_t& output)
                  channel);
 
     auto selector = data.address | (data.channel <<16);
-    this->write_register(this->addresses.bases.scope_mux + 4*channel+ 4, selector);
+    register_view<scope_mux_block> mux(hw, this->addresses.bases.scope_mux);
+    hw.declare_idempotent(mux.address<scope_mux_block::channel_selector>(channel));
+    mux.write<scope_mux_block::channel_selector>(channel, selector);
 }
 
 void hil_deployer::set_input(const std::string &core,  const std::string &name, uint16_t channel, double value) {
@@ -188,48 +195,75 @@ void hil_deployer::set_input(const std::string &core,  const std::string &name,
 
 void hil_deployer::start() {
     spdlog::info("START HIL");
-    this->write_register(this->addresses.bases.hil_control, 1);
+    register_view<hil_control_block>(hw, this->addresses.bases.hil_control).write<hil_control_block::run>(1);
 }
 
 void hil_deployer::stop() {
     spdlog::info("STOP HIL");
-    this->write_register(this->addresses.bases.hil_control, 0);
+    register_view<hil_control_block>(hw, this->addresses.bases.hil_control).write<hil_control_block::run>(0);
 }
 
 float hil_deployer::get_sampling_frequency() const {
     return timebase_frequency == 0 ? timebase_frequency : timebase_frequency;
 }
 
-hardware_sim_data_t hil_deployer::get_hardware_sim_data(const nlohmann::json &specs) {
+/// Produce the hardware simulation data of a HIL specification
+/// \param specs HIL specification, it is deployed on a sink bus if it is not the one currently deployed
+/// \param format Format of the code and control plane dumps
+/// \return Code and control plane dumps, together with the output and input labels
+hardware_sim_data_t hil_deployer::get_hardware_sim_data(const nlohmann::json &specs, hw_sim_format format) {
+    hardware_sim_data_t sim_data;
+    prepare_hardware_sim(specs);
+    std::tie(sim_data.code, sim_data.control) = hw.get_hardware_simulation_data(format);
+    fill_hardware_sim_labels(sim_data);
+    return sim_data;
+}
+
+/// Write the code and control plane dumps of a HIL specification to the hardware simulation directory
+/// \param specs HIL specification, it is deployed on a sink bus if it is not the one currently deployed
+/// \param name Base name of the dump files, it can not contain any path component
+/// \param format Format of the code and control plane dumps
+/// \return The paths of the dumps in place of their content, together with the labels, or nothing if the files can not
+/// be written
+std::optional<hardware_sim_data_t> hil_deployer::write_hardware_sim_data(const nlohmann::json &specs, const std::string &name, hw_sim_format format) {
+    std::string extension = ".txt";
+    if(format == hw_sim_format::hex) extension = ".hex";
+    else if(format == hw_sim_format::binary) extension = ".bin";
+
+    std::error_code ec;
+    std::filesystem::create_directories(runtime_config.hw_sim_dir, ec);
+    auto dir = std::filesystem::path(runtime_config.hw_sim_dir);
+
     hardware_sim_data_t sim_data;
+    sim_data.code = (dir / (name + "_code" + extension)).string();
+    sim_data.control = (dir / (name + "_control" + extension)).string();
+
+    prepare_hardware_sim(specs);
+    if(!hw.write_hardware_simulation_data(sim_data.code, sim_data.control, format)) return std::nullopt;
+    fill_hardware_sim_labels(sim_data);
+    return sim_data;
+}
+
+void hil_deployer::prepare_hardware_sim(const nlohmann::json &specs) {
     if(deployed_hash != std::hash<nlohmann::json>{}(specs)) {
         hw.disable_bus_access();
         deploy(specs);
         start();
         hw.enable_bus_access();
     }
+}
 
-    auto [rom, control] = hw.get_hardware_simulation_data();
-
-    std::string outputs;
+void hil_deployer::fill_hardware_sim_labels(hardware_sim_data_t &sim_data) {
     for(auto [key, name]:bus_labels) {
         std::ranges::replace(name, ' ', '_');
-        outputs += std::to_string(key) + ":" + name + "\n";
+        fmt::format_to(std::back_inserter(sim_data.outputs), "{}:{}\n", key, name);
     }
 
-    std::string inputs;
     for(auto &[name, tb]:inputs_labels) {
         auto ep = name;
         std::ranges::replace(ep, ' ', '_');
-        inputs += ep + "," + std::to_string(tb.peripheral) + "," + std::to_string(tb.destination) + "," + std::to_string(tb.selector) + "," + std::to_string(tb.core_idx) +"\n";
+        fmt::format_to(std::back_inserter(sim_data.inputs), "{},{},{},{},{}\n", ep, tb.peripheral, tb.destination, tb.selector, tb.core_idx);
     }
-
-    sim_data.inputs = inputs;
-    sim_data.outputs = outputs;
-    sim_data.code = rom;
-    sim_data.control = control;
-
-    return sim_data;
 }
 
 void hil_deployer::setup_interconnect_iv(const std::vector<fcore::deployed_program> &programs) {
@@ -374,7 +408,8 @@ void hil_deployer::setup_inputs(std::vector<fcore::deployed_program> &programs)
         }
 
         if(active_random_inputs>0) {
-            write_register(this->addresses.bases.noise_generator, active_random_inputs);
+            register_view<noise_generator_block> noise_gen(hw, this->addresses.bases.noise_generator);
+            noise_gen.write<noise_generator_block::active_outputs>(active_random_inputs);
         }
         spdlog::info("------------------------------------------------------------------");
     }
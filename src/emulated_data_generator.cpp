@@ -15,7 +15,7 @@
 
 #include "emulated_data_generator.hpp"
 
-emulated_data_generator::emulated_data_generator(uint32_t size) {
+emulated_data_generator::emulated_data_generator(uint32_t n_channels, uint32_t size) : n_channels(n_channels), data(n_channels) {
     external_emulator_data = false;
     buffer_size = size;
     chunk_counter = 0;
@@ -59,9 +59,18 @@ void emulated_data_generator::set_data_file(std::string file) {
 
     std::ifstream fs(file);
     nlohmann::json json_data = nlohmann::json::parse(fs);
-    std::array<std::vector<float>, n_channels> raw_data = json_data["data"];
+    std::vector<std::vector<float>> raw_data = json_data["data"];
+    if(raw_data.size() < n_channels){
+        std::cerr << "ERROR: Wrong data format in the specified emulation file, data for at least "<< std::to_string(n_channels)<< " channels is expected" <<std::endl;
+        exit(-1);
+    }
+    // files with more channels than the scope (i.e. the 7 channel files of the fixed geometry) are still accepted,
+    // the extra channels are never read out
+    if(raw_data.size() > n_channels){
+        std::cerr << "WARNING: The emulation file has data for "<< std::to_string(raw_data.size())<< " channels, only the first "<< std::to_string(n_channels)<< " are used" <<std::endl;
+    }
 
-    for(int i = 0; i< raw_data.size(); ++i){
+    for(int i = 0; i< n_channels; ++i){
         if(raw_data[i].size()%buffer_size!= 0){
             std::cerr << "ERROR: Wrong data format in the specified emulation file, each channel array must be a multiple of the buffer size ("<< std::to_string(buffer_size)<< ")" <<std::endl;
             exit(-1);
@@ -0,0 +1,137 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "hot_path_logging.hpp"
+
+std::atomic<hot_log_ring *> hot_path_logger::active_ring{nullptr};
+std::atomic<uint32_t> hot_path_logger::active_producers{0};
+std::atomic<bool> hot_path_logger::running{false};
+std::atomic<uint64_t> hot_path_logger::dropped{0};
+std::mutex hot_path_logger::config_mutex;
+std::unique_ptr<hot_log_ring> hot_path_logger::ring;
+std::thread hot_path_logger::formatting_thread;
+std::mutex hot_path_logger::wakeup_mutex;
+std::condition_variable hot_path_logger::wakeup;
+
+/// \param capacity Number of records in the ring, rounded up to the next power of two
+hot_log_ring::hot_log_ring(size_t capacity) : slots(std::bit_ceil(std::max<size_t>(capacity, 2))) {
+    mask = slots.size() - 1;
+    for(size_t i = 0; i<slots.size(); i++){
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool hot_log_ring::try_push(const hot_log_record &r) {
+    auto pos = enqueue_pos.load(std::memory_order_relaxed);
+    while(true){
+        auto &s = slots[pos & mask];
+        auto seq = s.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if(diff == 0){
+            if(enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+                s.record = r;
+                s.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if(diff < 0){
+            return false;
+        } else {
+            pos = enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool hot_log_ring::try_pop(hot_log_record &r) {
+    auto pos = dequeue_pos.load(std::memory_order_relaxed);
+    auto &s = slots[pos & mask];
+    auto seq = s.sequence.load(std::memory_order_acquire);
+    if(static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) < 0) return false;
+    r = s.record;
+    s.sequence.store(pos + mask + 1, std::memory_order_release);
+    dequeue_pos.store(pos + 1, std::memory_order_relaxed);
+    return true;
+}
+
+/// Route the hot path log messages through a ring buffer, they are formatted and emitted by a background thread
+/// \param capacity Number of messages that can be queued before new ones start being dropped
+void hot_path_logger::enable_async(size_t capacity) {
+    std::lock_guard<std::mutex> lock(config_mutex);
+    stop_async();
+    spdlog::info("Asynchronous hot path logging enabled ({0} records)", capacity);
+    ring = std::make_unique<hot_log_ring>(capacity);
+    static bool exit_handler_registered = false;
+    if(!exit_handler_registered){
+        std::atexit(&hot_path_logger::disable_async);
+        exit_handler_registered = true;
+    }
+    running = true;
+    formatting_thread = std::thread(&hot_path_logger::formatting_loop, ring.get());
+    active_ring.store(ring.get());
+}
+
+/// Go back to synchronous logging, all the queued messages are emitted before returning
+void hot_path_logger::disable_async() {
+    std::lock_guard<std::mutex> lock(config_mutex);
+    stop_async();
+}
+
+// Retire the ring and stop the formatting thread, must be called with the configuration mutex held
+void hot_path_logger::stop_async() {
+    if(!running) return;
+    active_ring.store(nullptr);
+    // wait for the producers that picked up the ring before it was retired, so that no push races with the final drain
+    while(active_producers.load() != 0) std::this_thread::yield();
+    running = false;
+    notify();
+    formatting_thread.join();
+    ring.reset();
+    if(dropped > 0) spdlog::warn("{0} hot path log messages were dropped", dropped.load());
+}
+
+void hot_path_logger::notify() {
+    wakeup.notify_one();
+}
+
+void hot_path_logger::formatting_loop(hot_log_ring *r) {
+    hot_log_record record{};
+    while(true){
+        bool was_running = running;
+        while(r->try_pop(record)) format_record(record);
+        if(!was_running) break;
+        std::unique_lock<std::mutex> lock(wakeup_mutex);
+        wakeup.wait_for(lock, std::chrono::milliseconds(5));
+    }
+}
+
+void hot_path_logger::format_record(const hot_log_record &r) {
+    fmt::dynamic_format_arg_store<fmt::format_context> store;
+    for(uint8_t i = 0; i<r.n_args; i++){
+        switch (r.args[i].kind) {
+            case hot_log_arg::unsigned_int:
+                store.push_back(r.args[i].u);
+                break;
+            case hot_log_arg::signed_int:
+                store.push_back(r.args[i].i);
+                break;
+            case hot_log_arg::floating:
+                store.push_back(r.args[i].f);
+                break;
+        }
+    }
+    try {
+        spdlog::log(r.level, "{}", fmt::vformat(r.format, store));
+    } catch (fmt::format_error &e) {
+        spdlog::error("Malformed hot path log message {0}: {1}", r.format, e.what());
+    }
+}
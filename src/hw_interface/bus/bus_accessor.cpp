@@ -17,8 +17,35 @@
 
 std::mutex m;
 
-std::atomic<bool> bus_accessor::sink_mode{false};
-
+// Holds the bus lock for the duration of a transaction. When the statistics are enabled it also accounts for the
+// transactions and for the time spent waiting for and holding the lock, which is attributed to the region of the first
+// address
+class bus_accessor::bus_lock {
+public:
+    bus_lock(bus_statistics &s, uint64_t address) : stats(s), address(address), timed(s.is_enabled()) {
+        if(timed) {
+            auto request = std::chrono::steady_clock::now();
+            lock = std::unique_lock<std::mutex>(m);
+            acquired = std::chrono::steady_clock::now();
+            wait = acquired - request;
+        } else {
+            lock = std::unique_lock<std::mutex>(m);
+        }
+    }
+    ~bus_lock() {
+        if(timed) stats.count_lock(address, wait, std::chrono::steady_clock::now() - acquired);
+    }
+    void count(uint64_t addr, bool write, uint64_t n_accesses = 1) {
+        if(timed) stats.count_access(addr, write, n_accesses);
+    }
+private:
+    bus_statistics &stats;
+    uint64_t address;
+    bool timed;
+    std::chrono::steady_clock::time_point acquired;
+    std::chrono::nanoseconds wait{0};
+    std::unique_lock<std::mutex> lock;
+};
 
 void sigsegv_handler(int dummy) {
     spdlog::error("Segmentation fault encounteded while communicating with FPGA");
@@ -30,159 +57,580 @@ void sigbus_handler(int dummy) {
     exit(-1);
 }
 
+/// Create a bus accessor using the backend selected through the BUS_BACKEND environment variable, the hardware
+/// backend is used by default, except for the emulate architecture where the simulated one is used
 bus_accessor::bus_accessor() {
 
     spdlog::info("fpga_bridge initialization started");
 
-    signal(SIGSEGV,sigsegv_handler);
-    signal(SIGBUS,sigbus_handler);
-    std::string arch;
-    if (const char * env_val = std::getenv("ARCH")) {
-        arch = env_val;
-    } else {
-        spdlog::error("The architecture must be selected with the ARCH environment variable");
-        exit(-1);
-    }
-    if(arch == "zynqmp"){
-        control_addr = ZYNQMP_REGISTERS_BASE_ADDR;
-        core_addr = ZYNQMP_FCORE_BASE_ADDR;
+    std::string type;
+    if (const char * env_val = std::getenv("BUS_BACKEND")) {
+        type = env_val;
     } else {
-        control_addr = ZYNQ_REGISTERS_BASE_ADDR;
-        core_addr = ZYNQ_FCORE_BASE_ADDR;
+        auto arch = std::getenv("ARCH");
+        type = arch != nullptr && std::string(arch) == "emulate" ? "simulated" : "hardware";
     }
+    backend = create_backend(type);
 
-    int n_pages_ctrl, n_pages_fcore;
+    spdlog::info("fpga_bridge initialization done");
+}
 
-    char const* t = getenv("MMAP_N_PAGES_CTRL");
-    if(t == nullptr){
-        n_pages_ctrl = 344000;
-    } else {
-        n_pages_ctrl = std::stoi(std::string(t));
-    }
+/// Create a bus accessor on top of an existing backend
+/// \param b Backend used for all bus transactions
+bus_accessor::bus_accessor(std::shared_ptr<bus_backend> b) {
+    backend = std::move(b);
+}
 
-    t = getenv("MMAP_N_PAGES_FCORE");
-    if(t == nullptr){
-        n_pages_fcore = 344000;
-    } else {
-        n_pages_fcore = std::stoi(std::string(t));
+bus_accessor::~bus_accessor() {
+    enable_write_behind(false);
+}
+
+/// Instantiate a bus backend by name
+/// \param type One of hardware, simulated or null, the recording_ prefix wraps the backend in a recording proxy
+/// \return The requested backend
+std::shared_ptr<bus_backend> bus_accessor::create_backend(const std::string &type) {
+    spdlog::info("Selected {0} bus backend", type);
+    if(type.starts_with("recording_")){
+        return std::make_shared<recording_bus_backend>(create_backend(type.substr(10)));
+    } else if(type == "hardware"){
+        std::string arch;
+        if (const char * env_val = std::getenv("ARCH")) {
+            arch = env_val;
+        } else {
+            spdlog::error("The architecture must be selected with the ARCH environment variable");
+            exit(-1);
+        }
+        signal(SIGSEGV,sigsegv_handler);
+        signal(SIGBUS,sigbus_handler);
+        return std::make_shared<mmap_bus_backend>(arch);
+    } else if(type == "simulated"){
+        std::chrono::nanoseconds latency(0);
+        if(char const* t = getenv("BUS_SIM_LATENCY_NS")){
+            latency = std::chrono::nanoseconds(std::stoull(std::string(t)));
+        }
+        return std::make_shared<simulated_bus_backend>(latency);
+    } else if(type == "null"){
+        return std::make_shared<null_bus_backend>();
     }
+    spdlog::error("Unknown bus backend: {0}", type);
+    exit(-1);
+}
+
+void bus_accessor::set_backend(std::shared_ptr<bus_backend> b) {
+    flush();
+    std::lock_guard<std::mutex> lock(m);
+    backend = std::move(b);
+}
+
+/// Start streaming all the bus transactions to a binary trace file, any trace already in progress is stopped first
+/// \param path Path of the trace file
+/// \return false if the trace file can not be created
+bool bus_accessor::start_trace(const std::string &path) {
+    stop_trace();
+    flush();
+    auto writer = std::make_shared<bus_trace_writer>(path);
+    if(!writer->is_open()) return false;
+
+    std::lock_guard<std::mutex> lock(m);
+    trace_writer = writer;
+    trace_proxy = std::make_shared<recording_bus_backend>(backend);
+    trace_proxy->set_trace_writer(trace_writer);
+    backend = trace_proxy;
+    return true;
+}
+
+/// Stop the trace in progress (if any) and close its file
+/// \return Number of transactions captured in the trace
+uint64_t bus_accessor::stop_trace() {
+    flush();
+    std::lock_guard<std::mutex> lock(m);
+    if(!trace_proxy) return 0;
 
-    auto registers_fd = open(if_dict.get_control_bus().c_str(), O_RDWR | O_SYNC);
-    if(registers_fd == -1){
-        spdlog::error( "Error while mapping the axi control bus");
-        exit(1);
+    if(backend == trace_proxy) backend = trace_proxy->get_target();
+    if(previous_backend == trace_proxy) previous_backend = trace_proxy->get_target();
+    trace_proxy.reset();
+
+    trace_writer->close();
+    auto n_transactions = trace_writer->get_n_transactions();
+    trace_writer.reset();
+    return n_transactions;
+}
+
+/// Re-issue a previously captured trace against the current backend. The bus is locked for each transaction, so the
+/// other clients of the bus are interleaved with the replay, and the shadow registers are discarded before and after it
+/// \param path Path of the trace file
+/// \param original_timing true to reproduce the timing of the original trace, false to replay it as fast as possible
+/// \param report Statistics about the replay
+/// \return false if the trace file can not be loaded
+bool bus_accessor::replay_trace(const std::string &path, bool original_timing, bus_replay_report &report) {
+    std::vector<bus_transaction> trace;
+    if(!bus_trace_reader::load(path, trace)) return false;
+
+    flush();
+    std::shared_ptr<bus_backend> target;
+    {
+        std::lock_guard<std::mutex> lock(m);
+        shadow_registers.clear();
+        target = backend;
     }
+    bus_trace_player player(target, &m);
+    report = player.replay(trace, original_timing);
+    std::lock_guard<std::mutex> lock(m);
+    shadow_registers.clear();
+    return true;
+}
+
+/// Route all subsequent bus transactions to a sink, they are still recorded in the operations log
+void bus_accessor::disable_access() {
+    flush();
+    std::lock_guard<std::mutex> lock(m);
+    previous_backend = backend;
+    backend = std::make_shared<null_bus_backend>();
+}
 
-    auto fcore_fd = open(if_dict.get_cores_bus().c_str(), O_RDWR | O_SYNC);
-    if(fcore_fd == -1){
-        spdlog::error("Error while mapping the fcore rom bus");
-        exit(1);
+void bus_accessor::enable_access() {
+    flush();
+    std::lock_guard<std::mutex> lock(m);
+    if(previous_backend) backend = previous_backend;
+}
+
+void bus_accessor::write_register(uint64_t address, uint32_t data) {
+    if(write_behind.load(std::memory_order_relaxed)) {
+        enqueue_write({address, 0, data});
+        return;
     }
+    bus_lock lock(stats, address);
+    issue_write(lock, {address, 0, data});
+}
 
-    spdlog::info("Mapping {0} memory pages from the axi control bus, starting at address: 0x{1:x}", n_pages_ctrl, control_addr);
-    registers = (uint32_t*) mmap(nullptr, n_pages_ctrl*4096, PROT_READ | PROT_WRITE, MAP_SHARED, registers_fd, control_addr);
-    if(registers == MAP_FAILED) {
-        spdlog::error("Cannot mmap control bus: {0}", strerror(errno));
-        exit(1);
+/// Write a group of registers in order, holding the bus lock once for the whole group
+/// \param writes Address and value of each write
+void bus_accessor::write_registers(std::span<const std::pair<uint64_t, uint32_t>> writes) {
+    if(writes.empty()) return;
+    if(write_behind.load(std::memory_order_relaxed)) {
+        for(auto &[address, data]:writes) enqueue_write({address, 0, data});
+        return;
     }
+    bus_lock lock(stats, writes.front().first);
+    for(auto &[address, data]:writes) issue_write(lock, {address, 0, data});
+}
 
-    spdlog::info("Mapping {0} memory pages from the fcore programming bus, starting at address: ", n_pages_fcore, core_addr);
-    fCore = (uint32_t*) mmap(nullptr, n_pages_fcore*4096, PROT_READ | PROT_WRITE, MAP_SHARED, fcore_fd, core_addr);
-    if(fCore == MAP_FAILED) {
-        spdlog::error("Cannot mmap fcore programming bus: {0}", strerror(errno));
-        exit(1);
+/// Write a register behind an AXI stream constant proxy, the target address is written first, followed by the value
+/// \param proxy_address Base address of the proxy
+/// \param target_address Address of the register behind the proxy
+/// \param data Value to write
+void bus_accessor::write_proxied(uint64_t proxy_address, uint64_t target_address, uint32_t data) {
+    if(write_behind.load(std::memory_order_relaxed)) {
+        enqueue_write({target_address, proxy_address, data});
+        return;
     }
+    bus_lock lock(stats, proxy_address);
+    issue_write(lock, {target_address, proxy_address, data});
+}
+
+uint32_t bus_accessor::read_register(uint64_t address) {
+    flush();
+    bus_lock lock(stats, address);
+    log_operation(control_plane_read, address, 0);
+    HOT_LOG_TRACE("READ from Register at address {0:x}", address);
+    lock.count(address, false);
+    return backend->read_register(address);
+}
 
+/// Read a group of registers in a single pass, holding the bus lock for the whole group so that the values are coherent
+/// \param addresses Addresses of the registers to read
+/// \return Values of the registers, in the same order as the addresses
+std::vector<uint32_t> bus_accessor::read_registers(const std::vector<uint64_t> &addresses) {
+    std::vector<uint32_t> values(addresses.size());
+    if(addresses.empty()) return values;
+    flush();
+    bus_lock lock(stats, addresses[0]);
+    for(size_t i = 0; i<addresses.size(); i++){
+        values[i] = backend->read_register(addresses[i]);
+        lock.count(addresses[i], false);
+    }
+    log_operation(control_plane_read, addresses, values);
+    return values;
+}
 
-    spdlog::info("fpga_bridge initialization done");
+/// Read a group of registers in a single locked pass without recording the access in the operations log, for use by
+/// periodic monitoring that would otherwise flood it
+/// \param addresses Addresses of the registers to read
+/// \param values Vector where the values are placed, it must be as large as the addresses one
+void bus_accessor::sample_registers(const std::vector<uint64_t> &addresses, std::vector<uint32_t> &values) {
+    if(addresses.empty()) return;
+    flush();
+    bus_lock lock(stats, addresses[0]);
+    for(size_t i = 0; i<addresses.size(); i++){
+        values[i] = backend->read_register(addresses[i]);
+        lock.count(addresses[i], false);
+    }
 }
 
-void bus_accessor::write_register(const std::vector<uint64_t>& addresses, uint64_t data) {
-    operations.push_back({addresses, {data}, control_plane_write});
-    if(!sink_mode){
-        m.lock();
-        if(addresses.size() ==1){
-            registers[register_address_to_index(addresses[0])] = data;
-        } else {
-            registers[register_address_to_index(addresses[1]+4)] = addresses[0];
-            registers[register_address_to_index(addresses[1])] = data;
+/// Atomically update a subset of the bits of a register, the read and write happen under a single hold of the bus lock
+/// \param address Address of the register to modify
+/// \param mask Bits of the register to update
+/// \param value New value for the selected bits (bits outside of the mask are ignored)
+/// \return Value of the register after the modification
+uint32_t bus_accessor::modify_register(uint64_t address, uint32_t mask, uint32_t value) {
+    uint32_t old_value;
+    uint32_t new_value;
+    flush();
+    {
+        bus_lock lock(stats, address);
+        old_value = backend->read_register(address);
+        lock.count(address, false);
+        new_value = (old_value & ~mask) | (value & mask);
+        if(!shadow_hit(address, new_value)) {
+            backend->write_register(address, new_value);
+            lock.count(address, true);
         }
-        m.unlock();
+        log_operation(control_plane_read, address, old_value);
+        log_operation(control_plane_write, address, new_value);
     }
+    HOT_LOG_TRACE("MODIFY Register at address {0:x}: 0x{1:x} -> 0x{2:x} (mask 0x{3:x})", address, old_value, new_value, mask);
+    return new_value;
 }
 
-uint32_t bus_accessor::read_register(const std::vector<uint64_t>& address) {
-        operations.push_back({address, {0}, control_plane_read});
-    if(!sink_mode){
-        uint32_t ret_val;
-        m.lock();
-        if(address.size()==1){
-            auto reg_n = register_address_to_index(address[0]);
-            spdlog::trace("READ from Register #{0} at address {1}", reg_n, address[0]);
-            ret_val = registers[reg_n];
-        } else{
-            ret_val = 0;
+/// Poll a register until the masked value matches the expected one. The register is polled in a tight loop for the first
+/// few microseconds, after which the poll interval is progressively increased up to 1ms. The bus lock is only held for
+/// each individual read and a single read operation is recorded for the whole wait.
+/// \param address Address of the register to poll
+/// \param mask Bits of the register to check
+/// \param expected Expected value of the masked bits
+/// \param timeout Maximum time to wait for the condition, clamped to max_wait_timeout
+/// \param value Last value read from the register
+/// \return true if the condition was met before the timeout expired
+bool bus_accessor::wait_for(uint64_t address, uint32_t mask, uint32_t expected, std::chrono::nanoseconds timeout, uint32_t &value) {
+    constexpr auto spin_time = std::chrono::microseconds(20);
+    constexpr auto max_sleep = std::chrono::milliseconds(1);
+
+    timeout = std::clamp<std::chrono::nanoseconds>(timeout, std::chrono::nanoseconds::zero(), max_wait_timeout);
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + timeout;
+    std::chrono::nanoseconds sleep_time = std::chrono::microseconds(1);
+    bool satisfied;
+    flush();
+    while(true){
+        {
+            bus_lock lock(stats, address);
+            value = backend->read_register(address);
+            lock.count(address, false);
+        }
+        satisfied = (value & mask) == (expected & mask);
+        auto now = std::chrono::steady_clock::now();
+        if(satisfied || now >= deadline) break;
+
+        if(now - start > spin_time){
+            std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(sleep_time, deadline - now));
+            sleep_time = std::min<std::chrono::nanoseconds>(sleep_time*2, max_sleep);
         }
-        m.unlock();
-        return ret_val;
-    } else {
-        return rand()%100;
     }
+    {
+        std::lock_guard<std::mutex> lock(m);
+        log_operation(control_plane_read, address, value);
+    }
+    return satisfied;
 }
 
-uint64_t bus_accessor::fcore_address_to_index(uint64_t address) const {
-    if(core_addr>address){
-        spdlog::critical("Tried to write the core address: 0x{0:x} which is below the minimum allowed: 0x{1:x}", address, control_addr);
-        exit(-1);
-    }
-    return (address - core_addr) / 4;
+/// Stream the ROM and control plane writes of the operations log to a pair of sinks
+/// \param rom Sink receiving the program words, one record per word
+/// \param control Sink receiving the control plane writes
+void bus_accessor::export_hardware_simulation_data(hw_sim_sink &rom, hw_sim_sink &control) const {
+    flush();
+    std::lock_guard<std::mutex> lock(m);
+    export_operations(rom, control);
 }
 
-std::pair<std::string, std::string> bus_accessor::get_hardware_simulation_data() {
-    std::string rom_plane, control_plane;
-    auto ops = get_operations();
-    for(auto &o:ops) {
+// Stream the operations log to the sinks, must be called with the bus lock held
+void bus_accessor::export_operations(hw_sim_sink &rom, hw_sim_sink &control) const {
+    for(auto &o:operations) {
+        auto payload = operations_payload.data() + o.payload_offset;
+        auto data = payload + o.n_addresses;
         if(o.type == rom_plane_write) {
-            auto rom_address = o.address[0];
-            for(int i = 0; i<o.data.size(); i++) {
-                rom_plane += std::to_string(rom_address + 4*i) + ":" + std::to_string(o.data[i]) + '\n';
+            for(uint32_t i = 0; i<o.n_data; i++) {
+                rom.put(payload[0] + 4*i, data[i]);
             }
         } else if(o.type == control_plane_write) {
-            for(int i = 0; i<o.data.size(); i++) {
-                control_plane += std::to_string(o.address[i]) + ":"  + std::to_string(o.data[i]) + "\n";
+            for(uint32_t i = 0; i<o.n_data; i++) {
+                control.put(payload[i], data[i]);
             }
         }
     }
+    rom.flush();
+    control.flush();
+}
+
+/// Produce the hardware simulation dumps in memory
+/// \param format Format of the dumps
+/// \return Pair of ROM plane and control plane dumps
+std::pair<std::string, std::string> bus_accessor::get_hardware_simulation_data(hw_sim_format format) const {
+    flush();
+    std::lock_guard<std::mutex> lock(m);
+    size_t n_rom = 0, n_control = 0;
+    for(auto &o:operations) {
+        if(o.type == rom_plane_write) n_rom += o.n_data;
+        else if(o.type == control_plane_write) n_control += o.n_data;
+    }
+
+    std::string rom_plane, control_plane;
+    rom_plane.reserve(n_rom*hw_sim_sink::max_record_size(format));
+    control_plane.reserve(n_control*hw_sim_sink::max_record_size(format));
+    {
+        hw_sim_sink rom(rom_plane, format);
+        hw_sim_sink control(control_plane, format);
+        export_operations(rom, control);
+    }
     return {rom_plane, control_plane};
 }
 
-uint64_t bus_accessor::register_address_to_index(uint64_t address) const {
-    if(control_addr>address){
-        spdlog::critical("Tried to write the control address: 0x{0:x} which is below the minimum allowed: 0x{1:x}", address, control_addr);
-        exit(-1);
+/// Write the hardware simulation dumps straight to disk
+/// \param rom_path Path of the ROM plane dump
+/// \param control_path Path of the control plane dump
+/// \param format Format of the dumps
+/// \return false if any of the files can not be written
+bool bus_accessor::write_hardware_simulation_data(const std::string &rom_path, const std::string &control_path, hw_sim_format format) const {
+    std::ofstream rom_file(rom_path, std::ios::binary | std::ios::trunc);
+    std::ofstream control_file(control_path, std::ios::binary | std::ios::trunc);
+    if(!rom_file.is_open() || !control_file.is_open()) {
+        spdlog::error("Unable to open the hardware simulation files {0} and {1}", rom_path, control_path);
+        return false;
+    }
+    {
+        hw_sim_sink rom(rom_file, format);
+        hw_sim_sink control(control_file, format);
+        export_hardware_simulation_data(rom, control);
     }
-    return (address - control_addr) / 4;
+    return rom_file.good() && control_file.good();
 }
 
-void bus_accessor::load_program(uint64_t address, const std::vector<uint32_t> program) {
+/// Map a control plane range ahead of its use, so that the first access to it does not have to pay for the mapping
+/// \param address Start of the range
+/// \param size Size of the range in bytes
+void bus_accessor::map_control_region(uint64_t address, uint64_t size) {
+    std::lock_guard<std::mutex> lock(m);
+    backend->map_region(address, size);
+}
 
-    std::vector<uint64_t> pn;
-    std::vector<uint64_t> a = {address};
+void bus_accessor::load_program(uint64_t address, const std::vector<uint32_t> &program) {
+    flush();
+    {
+        bus_lock lock(stats, address);
+        backend->load_program(address, program.data(), program.size());
+        lock.count(address, true, program.size());
+        log_operation(rom_plane_write, std::array<uint64_t, 1>{address}, program);
+    }
+}
 
-    if(sink_mode){
-        for (auto &p:program) {
-            pn.push_back(p);
-        }
+/// Materialize the operations log
+/// \return All the bus operations performed since the log was last cleared
+std::vector<bus_op> bus_accessor::get_operations() const {
+    flush();
+    std::lock_guard<std::mutex> lock(m);
+    std::vector<bus_op> ret;
+    ret.reserve(operations.size());
+    for(auto &o:operations){
+        auto addr_begin = operations_payload.begin() + o.payload_offset;
+        auto data_begin = addr_begin + o.n_addresses;
+        ret.push_back({
+            std::vector<uint64_t>(addr_begin, data_begin),
+            std::vector<uint64_t>(data_begin, data_begin + o.n_data),
+            o.type
+        });
+    }
+    return ret;
+}
+
+void bus_accessor::clear_operations() {
+    flush();
+    std::lock_guard<std::mutex> lock(m);
+    operations.clear();
+    operations_payload.clear();
+    log_truncated = false;
+}
+
+/// Enable or disable the shadow register file, any value cached so far is discarded
+/// \param enabled true to elide redundant writes to idempotent registers
+void bus_accessor::enable_shadow(bool enabled) {
+    flush();
+    std::lock_guard<std::mutex> lock(m);
+    spdlog::info("SHADOW REGISTERS: {0}", enabled ? "enabled" : "disabled");
+    shadow_enabled = enabled;
+    shadow_registers.clear();
+}
+
+/// Mark a control plane register as idempotent, so that writing the value it already holds has no effect on the hardware
+/// \param address Address of the register
+void bus_accessor::declare_idempotent(uint64_t address) {
+    std::lock_guard<std::mutex> lock(m);
+    idempotent_registers.insert(address);
+}
+
+/// Forget all the cached register values, to be called whenever the hardware state can have changed behind our back
+void bus_accessor::invalidate_shadow() {
+    flush();
+    std::lock_guard<std::mutex> lock(m);
+    spdlog::trace("SHADOW REGISTERS: invalidated {0} cached values", shadow_registers.size());
+    shadow_registers.clear();
+}
+
+/// Check whether a write to an idempotent register would be elided, without performing it. Any queued write is issued
+/// first, so that the answer reflects what the hardware holds
+/// \param address Address of the register
+/// \param data Value that would be written
+/// \return true if the register is known to already hold the value
+bool bus_accessor::shadow_holds(uint64_t address, uint32_t data) {
+    flush();
+    std::lock_guard<std::mutex> lock(m);
+    if(!shadow_enabled || !idempotent_registers.contains(address)) return false;
+    auto entry = shadow_registers.find(address);
+    return entry != shadow_registers.end() && entry->second == data;
+}
+
+/// Check a pending write against the shadow register file, updating it when the write must go through.
+/// must be called with the bus lock held
+/// \param address Address of the register to write
+/// \param data Value to write
+/// \return true if the register is known to already hold the value and the write can be skipped
+bool bus_accessor::shadow_hit(uint64_t address, uint32_t data) {
+    if(!shadow_enabled || !idempotent_registers.contains(address)) return false;
+
+    auto [entry, inserted] = shadow_registers.try_emplace(address, data);
+    if(!inserted && entry->second == data){
+        elided_writes++;
+        return true;
+    }
+    entry->second = data;
+    return false;
+}
+
+/// Enable or disable the collection of per region bus statistics
+/// \param enabled true to start counting the bus transactions
+void bus_accessor::enable_stats(bool enabled) {
+    spdlog::info("BUS STATISTICS: {0}", enabled ? "enabled" : "disabled");
+    stats.enable(enabled);
+}
+
+/// Name a region of the bus, so that the transactions targeting it are accounted separately in the statistics
+/// \param name Name of the region
+/// \param base Start address of the region
+/// \param size Size of the region in bytes, 0 to extend it up to the next region
+void bus_accessor::define_region(const std::string &name, uint64_t base, uint64_t size) {
+    std::lock_guard<std::mutex> lock(m);
+    stats.define_region(name, base, size);
+}
+
+/// \return Counters for all the named regions, followed by the ones for the transactions outside of them
+std::vector<bus_region_report> bus_accessor::get_stats() {
+    std::lock_guard<std::mutex> lock(m);
+    return stats.get_report();
+}
+
+void bus_accessor::reset_stats() {
+    std::lock_guard<std::mutex> lock(m);
+    stats.reset();
+}
+
+/// Perform a register write, must be called with the bus lock held
+/// \param lock Lock on the bus, used to account for the write
+/// \param w Write to perform
+void bus_accessor::issue_write(bus_lock &lock, const queued_write &w) {
+    if(w.proxy_address == 0) {
+        log_operation(control_plane_write, w.address, w.data);
+        if(shadow_hit(w.address, w.data)) return;
+        backend->write_register(w.address, w.data);
+        lock.count(w.address, true);
     } else {
-        m.lock();
-        a = {address};
-        for(int i = 0; i< program.size(); i++){
-            fCore[i+fcore_address_to_index(address)] = program[i];
-            pn.push_back(program[i]);
-            usleep(1);
-        }
-        m.unlock();
+        log_operation(control_plane_write, std::array<uint64_t, 2>{w.address, w.proxy_address}, std::array<uint64_t, 1>{w.data});
+        shadow_registers.erase(w.proxy_address);
+        shadow_registers.erase(w.proxy_address+4);
+        backend->write_register(w.proxy_address+4, w.address);
+        backend->write_register(w.proxy_address, w.data);
+        lock.count(w.proxy_address, true, 2);
+    }
+}
+
+/// Enable or disable the write behind mode, where register writes return as soon as they are queued and are issued
+/// in order by a dedicated bus thread. Any read, program load or backend change waits for the queued writes first.
+/// Must not be called concurrently with other bus transactions.
+/// \param enabled true to queue the register writes
+/// \param capacity Maximum number of queued writes, writers wait for the bus thread when the queue is full
+void bus_accessor::enable_write_behind(bool enabled, size_t capacity) {
+    if(enabled == bus_thread_running.load()) return;
+    if(enabled) {
+        spdlog::info("WRITE BEHIND: enabled ({0} writes)", capacity);
+        write_queue = std::make_unique<write_behind_queue>(capacity);
+        bus_thread_running = true;
+        bus_thread = std::thread(&bus_accessor::bus_thread_loop, this);
+        write_behind = true;
+    } else {
+        spdlog::info("WRITE BEHIND: disabled");
+        write_behind = false;
+        flush();
+        bus_thread_running = false;
+        doorbell.fetch_add(1, std::memory_order_release);
+        doorbell.notify_one();
+        bus_thread.join();
+        write_queue.reset();
+    }
+}
+
+/// Wait for all the writes queued so far by the write behind mode to be issued on the bus
+void bus_accessor::flush() const {
+    auto target = enqueued_writes.load(std::memory_order_acquire);
+    auto done = completed_writes.load(std::memory_order_acquire);
+    while(done < target) {
+        completed_writes.wait(done, std::memory_order_acquire);
+        done = completed_writes.load(std::memory_order_acquire);
     }
-        operations.push_back({a, pn, rom_plane_write});
 }
 
+/// Drain the write behind queue and take the bus lock, so that no transaction reaches the fabric while the lock is held.
+/// The bus thread and any other caller block until the lock is released. The shadow registers are discarded, as the
+/// lock is meant to be held across a reconfiguration of the fabric.
+/// \return Lock on the bus
+std::unique_lock<std::mutex> bus_accessor::quiesce() {
+    flush();
+    std::unique_lock<std::mutex> lock(m);
+    shadow_registers.clear();
+    return lock;
+}
+
+void bus_accessor::enqueue_write(const queued_write &w) {
+    while(!write_queue->try_push(w)) {
+        doorbell.notify_one();
+        std::this_thread::yield();
+    }
+    enqueued_writes.fetch_add(1, std::memory_order_release);
+    doorbell.fetch_add(1, std::memory_order_release);
+    doorbell.notify_one();
+}
+
+void bus_accessor::bus_thread_loop() {
+    // issue the queued writes in batches, so that back to back writes only take the bus lock once
+    constexpr uint64_t max_batch = 64;
+    queued_write w{};
+    while(true) {
+        auto bell = doorbell.load(std::memory_order_acquire);
+        if(!write_queue->try_pop(w)) {
+            if(!bus_thread_running.load()) break;
+            doorbell.wait(bell, std::memory_order_acquire);
+            continue;
+        }
+        uint64_t n_writes = 0;
+        {
+            bus_lock lock(stats, w.proxy_address == 0 ? w.address : w.proxy_address);
+            do {
+                // there is no caller left to report the error to, so an invalid write is logged and dropped
+                try {
+                    issue_write(lock, w);
+                } catch (invalid_bus_access &e) {
+                    spdlog::error("WRITE BEHIND: {0}", e.what());
+                }
+                n_writes++;
+            } while(n_writes < max_batch && write_queue->try_pop(w));
+        }
+        completed_writes.fetch_add(n_writes, std::memory_order_release);
+        completed_writes.notify_all();
+    }
+}
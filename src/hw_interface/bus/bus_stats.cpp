@@ -0,0 +1,113 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "hw_interface/bus/bus_stats.hpp"
+#include "hw_interface/bus/bus_accessor.hpp"
+
+/// Add a named region, or move an existing one keeping its counters
+/// \param name Name of the region
+/// \param base Start address of the region
+/// \param size Size of the region in bytes, 0 to extend it up to the next region
+void bus_statistics::define_region(const std::string &name, uint64_t base, uint64_t size) {
+    auto existing = std::ranges::find(regions, name, &region::name);
+    if(existing != regions.end()){
+        existing->base = base;
+        existing->size = size;
+    } else {
+        regions.push_back({name, base, size, {}});
+    }
+    std::ranges::sort(regions, {}, &region::base);
+    last_region = 0;
+}
+
+/// Account for bus transactions
+/// \param address Address of the transactions
+/// \param write true for writes, false for reads
+/// \param n_accesses Number of 32 bit words transferred
+void bus_statistics::count_access(uint64_t address, bool write, uint64_t n_accesses) {
+    auto &s = find_region(address);
+    if(write) s.writes += n_accesses;
+    else s.reads += n_accesses;
+    s.bytes += 4*n_accesses;
+}
+
+/// Account for a hold of the bus lock
+/// \param address Address of the first transaction performed under the lock
+/// \param wait Time spent waiting to acquire the lock
+/// \param hold Time the lock was held
+void bus_statistics::count_lock(uint64_t address, std::chrono::nanoseconds wait, std::chrono::nanoseconds hold) {
+    auto &s = find_region(address);
+    s.lock_hold_ns += hold.count();
+    s.max_lock_wait_ns = std::max<uint64_t>(s.max_lock_wait_ns, wait.count());
+}
+
+/// \return Counters of all the regions, followed by the ones for addresses outside of any region
+std::vector<bus_region_report> bus_statistics::get_report() const {
+    std::vector<bus_region_report> ret;
+    ret.reserve(regions.size() + 1);
+    for(auto &r:regions) ret.push_back({r.name, r.base, r.size, r.stats});
+    ret.push_back({"unmapped", 0, 0, unmapped});
+    return ret;
+}
+
+void bus_statistics::reset() {
+    for(auto &r:regions) r.stats = {};
+    unmapped = {};
+}
+
+bus_region_stats &bus_statistics::find_region(uint64_t address) {
+    // consecutive accesses tend to hit the same block, so check the last region used before searching
+    if(last_region < regions.size()){
+        auto &r = regions[last_region];
+        bool below_next = last_region + 1 == regions.size() || address < regions[last_region + 1].base;
+        if(address >= r.base && below_next && (r.size == 0 || address < r.base + r.size)) return r.stats;
+    }
+
+    auto next = std::ranges::upper_bound(regions, address, {}, &region::base);
+    if(next == regions.begin()) return unmapped;
+    auto r = std::prev(next);
+    if(r->size != 0 && address >= r->base + r->size) return unmapped;
+    last_region = r - regions.begin();
+    return r->stats;
+}
+
+/// Start logging the bus statistics, enabling their collection
+/// \param ba Bus accessor to monitor
+/// \param interval Time between two dumps
+bus_stats_logger::bus_stats_logger(std::shared_ptr<bus_accessor> ba, std::chrono::seconds interval) :
+        busses(std::move(ba)), interval(interval) {
+    busses->enable_stats(true);
+    worker = std::thread(&bus_stats_logger::logging_loop, this);
+}
+
+bus_stats_logger::~bus_stats_logger() {
+    {
+        std::lock_guard<std::mutex> lock(stop_mutex);
+        stop_requested = true;
+    }
+    stop_cv.notify_all();
+    if(worker.joinable()) worker.join();
+}
+
+void bus_stats_logger::logging_loop() {
+    std::unique_lock<std::mutex> lock(stop_mutex);
+    while(!stop_cv.wait_for(lock, interval, [this]{return stop_requested;})){
+        for(auto &r:busses->get_stats()){
+            if(r.stats.reads == 0 && r.stats.writes == 0) continue;
+            spdlog::info("BUS STATS: {0} (0x{1:x}): {2} reads, {3} writes, {4} bytes, {5} us under lock, max lock wait {6} us",
+                         r.name, r.base, r.stats.reads, r.stats.writes, r.stats.bytes, r.stats.lock_hold_ns/1000,
+                         r.stats.max_lock_wait_ns/1000);
+        }
+    }
+}
@@ -0,0 +1,130 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "hw_interface/bus/bus_trace.hpp"
+
+/// Create a new trace file, an existing file is never overwritten
+/// \param path Path of the trace file
+bus_trace_writer::bus_trace_writer(const std::string &path) {
+    std::error_code ec;
+    if(std::filesystem::exists(path, ec)){
+        spdlog::error("The bus trace file {0} already exists", path);
+        return;
+    }
+    output.open(path, std::ios::binary);
+    if(!output.is_open()){
+        spdlog::error("Unable to open bus trace file {0}", path);
+        return;
+    }
+    output.write(bus_trace_magic, sizeof(bus_trace_magic));
+    output.write(reinterpret_cast<const char *>(&bus_trace_version), sizeof(bus_trace_version));
+}
+
+bus_trace_writer::~bus_trace_writer() {
+    close();
+}
+
+/// Check that a trace name is a single plain file name, so that it can not escape the traces directory
+/// \param name Name to check
+/// \return true if the name only contains alphanumeric characters, dashes, underscores and dots
+bool bus_trace_writer::is_valid_name(const std::string &name) {
+    if(name.empty() || name == "." || name == "..") return false;
+    return std::ranges::all_of(name, [](char c){
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '-' || c == '.';
+    });
+}
+
+void bus_trace_writer::append(const bus_transaction &t) {
+    if(!output.is_open()) return;
+    bus_trace_record r = {t.timestamp, t.address, t.value, static_cast<uint8_t>(t.type)};
+    output.write(reinterpret_cast<const char *>(&r), sizeof(r));
+    n_transactions++;
+}
+
+void bus_trace_writer::close() {
+    if(output.is_open()) output.close();
+}
+
+/// Load a whole trace file in memory
+/// \param path Path of the trace file
+/// \param trace Vector where the transactions are placed
+/// \return false if the file can not be opened or is not a valid trace
+bool bus_trace_reader::load(const std::string &path, std::vector<bus_transaction> &trace) {
+    std::ifstream input(path, std::ios::binary);
+    if(!input.is_open()) return false;
+
+    char magic[4];
+    uint32_t version;
+    input.read(magic, sizeof(magic));
+    input.read(reinterpret_cast<char *>(&version), sizeof(version));
+    if(!input || std::string(magic, 4) != std::string(bus_trace_magic, 4) || version != bus_trace_version){
+        spdlog::error("Invalid bus trace file {0}", path);
+        return false;
+    }
+
+    bus_trace_record r{};
+    while(input.read(reinterpret_cast<char *>(&r), sizeof(r))){
+        trace.push_back({r.timestamp, r.address, r.value, static_cast<bus_access_type>(r.type)});
+    }
+    return true;
+}
+
+/// Re-issue a trace against the target backend
+/// \param trace Transactions to replay
+/// \param original_timing true to respect the spacing between transactions of the original trace, false to replay it
+/// as fast as possible
+/// \return Statistics about the replay
+bus_replay_report bus_trace_player::replay(const std::vector<bus_transaction> &trace, bool original_timing) {
+    bus_replay_report report;
+    if(trace.empty()) return report;
+
+    auto start = std::chrono::steady_clock::now();
+    auto first_timestamp = trace.front().timestamp;
+    for(auto &t:trace){
+        if(original_timing){
+            auto deadline = start + std::chrono::nanoseconds(t.timestamp - first_timestamp);
+            if(deadline - std::chrono::steady_clock::now() > std::chrono::microseconds(100)){
+                std::this_thread::sleep_until(deadline - std::chrono::microseconds(50));
+            }
+            while(std::chrono::steady_clock::now() < deadline);
+        }
+        // the bus is only held for the transaction itself, never while waiting for the next one
+        std::unique_lock<std::mutex> lock;
+        if(bus_mutex != nullptr) lock = std::unique_lock(*bus_mutex);
+        switch (t.type) {
+            case control_plane_write:
+                target->write_register(t.address, t.value);
+                break;
+            case control_plane_read:
+                target->read_register(t.address);
+                break;
+            case rom_plane_write:
+                target->load_program(t.address, &t.value, 1);
+                break;
+            case rom_plane_read:
+                break;
+        }
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    report.n_transactions = trace.size();
+    report.trace_duration = trace.back().timestamp - first_timestamp;
+    report.replay_duration = elapsed.count();
+    if(report.replay_duration > 0){
+        report.throughput = static_cast<double>(report.n_transactions) * 1e9 / static_cast<double>(report.replay_duration);
+    }
+    spdlog::info("BUS TRACE REPLAY: {0} transactions in {1} ns ({2:.0f} transactions/s)", report.n_transactions,
+                 report.replay_duration, report.throughput);
+    return report;
+}
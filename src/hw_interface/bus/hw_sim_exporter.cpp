@@ -0,0 +1,96 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+
+#include "hw_interface/bus/hw_sim_exporter.hpp"
+
+/// Create a sink appending to a string
+/// \param target String the records are appended to, it should be reserved by the caller to avoid reallocations
+/// \param format Format of the records
+hw_sim_sink::hw_sim_sink(std::string &target, hw_sim_format format) : format(format), string_target(&target),
+                                                                      buffer(new char[buffer_size]) {}
+
+/// Create a sink writing to a stream (usually a file)
+/// \param target Stream the records are written to
+/// \param format Format of the records
+hw_sim_sink::hw_sim_sink(std::ostream &target, hw_sim_format format) : format(format), stream_target(&target),
+                                                                       buffer(new char[buffer_size]) {}
+
+hw_sim_sink::~hw_sim_sink() {
+    flush();
+}
+
+/// Append a single address/data pair to the sink
+/// \param address Bus address
+/// \param data Value written at the address
+void hw_sim_sink::put(uint64_t address, uint64_t data) {
+    if(fill + max_record_size(format) > buffer_size) flush();
+    char *out = buffer.get() + fill;
+    char *end = buffer.get() + buffer_size;
+    switch (format) {
+        case hw_sim_format::text:
+            out = std::to_chars(out, end, address).ptr;
+            *out++ = ':';
+            out = std::to_chars(out, end, data).ptr;
+            *out++ = '\n';
+            break;
+        case hw_sim_format::hex:
+            out = put_hex(out, address, 16);
+            *out++ = ' ';
+            out = put_hex(out, data & 0xFFFFFFFF, 8);
+            *out++ = '\n';
+            break;
+        case hw_sim_format::binary:
+            hw_sim_record r = {address, static_cast<uint32_t>(data)};
+            std::memcpy(out, &r, sizeof(r));
+            out += sizeof(r);
+            break;
+    }
+    fill = out - buffer.get();
+}
+
+/// Move the buffered records to the target
+void hw_sim_sink::flush() {
+    if(fill == 0) return;
+    if(string_target != nullptr) {
+        string_target->append(buffer.get(), fill);
+    } else {
+        stream_target->write(buffer.get(), static_cast<std::streamsize>(fill));
+    }
+    fill = 0;
+}
+
+/// Upper bound of the size of a record
+/// \param format Format of the record
+/// \return Size in bytes
+size_t hw_sim_sink::max_record_size(hw_sim_format format) {
+    switch (format) {
+        case hw_sim_format::text:
+            return 2*20 + 2;
+        case hw_sim_format::hex:
+            return 16 + 8 + 2;
+        case hw_sim_format::binary:
+        default:
+            return sizeof(hw_sim_record);
+    }
+}
+
+char *hw_sim_sink::put_hex(char *out, uint64_t value, int digits) {
+    constexpr char hex_digits[] = "0123456789abcdef";
+    for(int i = digits-1; i>=0; i--) {
+        out[i] = hex_digits[value & 0xF];
+        value >>= 4;
+    }
+    return out + digits;
+}
@@ -0,0 +1,136 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "hw_interface/bus/mapped_bus.hpp"
+
+/// Open a memory mapped bus without mapping any of it, regions are mapped on demand when first accessed
+/// \param device Path of the device file exposing the bus
+/// \param base_address Physical address of the start of the bus
+/// \param aperture_size Size in bytes of the addressable portion of the bus
+/// \param bus_name Name of the bus, used in log and error messages
+mapped_bus::mapped_bus(const std::string &device, uint64_t base_address, uint64_t aperture_size, std::string bus_name) {
+    name = std::move(bus_name);
+    base = base_address;
+    aperture_end = base_address + aperture_size;
+    page_size = sysconf(_SC_PAGESIZE);
+
+    fd = open(device.c_str(), O_RDWR | O_SYNC);
+    if(fd == -1){
+        spdlog::error("Error while opening the {0}: {1}", name, strerror(errno));
+        exit(1);
+    }
+    spdlog::info("Opened the {0}, addressable range: 0x{1:x}-0x{2:x}", name, base, aperture_end);
+}
+
+mapped_bus::~mapped_bus() {
+    for(auto &r:regions){
+        munmap((void *) r.ptr, r.end - r.start);
+    }
+    close(fd);
+}
+
+/// Make sure that a range of addresses is mapped, merging it with any mapped region it overlaps or touches.
+/// \param address Start of the range to map
+/// \param size Size of the range in bytes
+/// \return false if the range falls outside of the bus aperture, throws invalid_bus_access if it can not be mapped
+bool mapped_bus::map_region(uint64_t address, uint64_t size) {
+    size = std::max<uint64_t>(size, 4);
+    if(address < base || address + size > aperture_end){
+        spdlog::warn("Skipping the mapping of range 0x{0:x}-0x{1:x} as it is outside of the {2}", address, address+size, name);
+        return false;
+    }
+
+    uint64_t start = address & ~(page_size-1);
+    uint64_t end = (address + size + page_size - 1) & ~(page_size-1);
+
+    auto first = std::ranges::lower_bound(regions, start, {}, &region::end);
+    auto last = first;
+    while(last != regions.end() && last->start <= end){
+        start = std::min(start, last->start);
+        end = std::max(end, last->end);
+        ++last;
+    }
+    if(last - first == 1 && first->start == start && first->end == end) return true;
+
+    auto ptr = (volatile uint32_t *) mmap(nullptr, end - start, PROT_READ | PROT_WRITE, MAP_SHARED, fd, start);
+    if(ptr == MAP_FAILED) {
+        auto msg = fmt::format("Cannot mmap the range 0x{:x}-0x{:x} of the {}: {}", start, end, name, strerror(errno));
+        spdlog::error(msg);
+        throw invalid_bus_access(msg);
+    }
+    for(auto r = first; r != last; ++r){
+        munmap((void *) r->ptr, r->end - r->start);
+    }
+    auto pos = regions.erase(first, last);
+    regions.insert(pos, {start, end, ptr});
+    last_hit = 0;
+
+    spdlog::info("Mapped {0} pages from the {1}, starting at address: 0x{2:x}", (end - start)/page_size, name, start);
+    return true;
+}
+
+/// Translate a bus address to a pointer into the mapped memory, mapping the window containing it if needed
+/// \param address Address to translate
+/// \return Pointer to the register at the given address
+volatile uint32_t *mapped_bus::translate(uint64_t address) {
+    if(auto r = find_region(address)) return r->ptr + (address - r->start)/4;
+
+    check_aperture(address, 4);
+    uint64_t window_start = std::max(address & ~(window_size-1), base);
+    uint64_t window_end = std::min(window_start + window_size, aperture_end);
+    map_region(window_start, window_end - window_start);
+    auto r = find_region(address);
+    return r->ptr + (address - r->start)/4;
+}
+
+/// Translate a range of bus addresses, guaranteeing that the whole range is contiguous in the returned mapping
+/// \param address Start of the range
+/// \param size Size of the range in bytes
+/// \return Pointer to the first register of the range
+volatile uint32_t *mapped_bus::translate(uint64_t address, uint64_t size) {
+    auto r = find_region(address);
+    if(r == nullptr || r->end < address + size){
+        check_aperture(address, size);
+        map_region(address, size);
+        r = find_region(address);
+    }
+    return r->ptr + (address - r->start)/4;
+}
+
+uint64_t mapped_bus::get_mapped_size() const {
+    uint64_t total = 0;
+    for(auto &r:regions) total += r.end - r.start;
+    return total;
+}
+
+const mapped_bus::region *mapped_bus::find_region(uint64_t address) {
+    if(last_hit < regions.size()){
+        auto &r = regions[last_hit];
+        if(address >= r.start && address < r.end) return &r;
+    }
+    auto it = std::ranges::upper_bound(regions, address, {}, &region::start);
+    if(it == regions.begin()) return nullptr;
+    --it;
+    if(address >= it->end) return nullptr;
+    last_hit = it - regions.begin();
+    return &*it;
+}
+
+void mapped_bus::check_aperture(uint64_t address, uint64_t size) const {
+    if(address < base || address + size > aperture_end){
+        auto msg = fmt::format("Tried to access the address 0x{:x} which is outside of the {} (0x{:x}-0x{:x})", address, name, base, aperture_end);
+        spdlog::error(msg);
+        throw invalid_bus_access(msg);
+    }
+}
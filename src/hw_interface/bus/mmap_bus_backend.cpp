@@ -0,0 +1,93 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "hw_interface/bus/mmap_bus_backend.hpp"
+
+/// Open the AXI control and fCore programming busses of the selected architecture
+/// \param arch Name of the target architecture (zynq or zynqmp)
+mmap_bus_backend::mmap_bus_backend(const std::string &arch) {
+    uint64_t control_addr, core_addr;
+    if(arch == "zynqmp"){
+        control_addr = ZYNQMP_REGISTERS_BASE_ADDR;
+        core_addr = ZYNQMP_FCORE_BASE_ADDR;
+    } else {
+        control_addr = ZYNQ_REGISTERS_BASE_ADDR;
+        core_addr = ZYNQ_FCORE_BASE_ADDR;
+    }
+
+    uint64_t n_pages_ctrl, n_pages_fcore;
+
+    char const* t = getenv("MMAP_N_PAGES_CTRL");
+    if(t == nullptr){
+        n_pages_ctrl = 344000;
+    } else {
+        n_pages_ctrl = std::stoull(std::string(t));
+    }
+
+    t = getenv("MMAP_N_PAGES_FCORE");
+    if(t == nullptr){
+        n_pages_fcore = 344000;
+    } else {
+        n_pages_fcore = std::stoull(std::string(t));
+    }
+
+    // Both busses are opened with O_SYNC, the memory type of the mapping is still chosen by the mmap handler of the
+    // kernel module, which is expected to map them uncached (pgprot_noncached). A cacheable mapping would let the
+    // program words sit in the cache, as the barrier at the end of a batched load only orders the stores.
+    t = getenv("FCORE_BATCHED_LOAD");
+    batched_rom_load = t != nullptr && std::string(t) != "0";
+    if(batched_rom_load) spdlog::info("The fcore programs are loaded in a single batch");
+
+    control_bus = std::make_unique<mapped_bus>(if_dict.get_control_bus(), control_addr, n_pages_ctrl*4096, "axi control bus");
+    cores_bus = std::make_unique<mapped_bus>(if_dict.get_cores_bus(), core_addr, n_pages_fcore*4096, "fcore programming bus");
+}
+
+/// Use already opened busses
+/// \param control AXI control bus
+/// \param cores fCore programming bus
+/// \param batched_rom_load true to load the programs without pacing the individual words
+mmap_bus_backend::mmap_bus_backend(std::unique_ptr<mapped_bus> control, std::unique_ptr<mapped_bus> cores, bool batched_rom_load) {
+    control_bus = std::move(control);
+    cores_bus = std::move(cores);
+    this->batched_rom_load = batched_rom_load;
+}
+
+void mmap_bus_backend::write_register(uint64_t address, uint32_t value) {
+    *control_bus->translate(address) = value;
+}
+
+uint32_t mmap_bus_backend::read_register(uint64_t address) {
+    return *control_bus->translate(address);
+}
+
+void mmap_bus_backend::load_program(uint64_t address, const uint32_t *program, size_t size) {
+    auto rom = cores_bus->translate(address, size*4);
+    if(batched_rom_load){
+        // back to back word sized stores (no memcpy, that could use accesses the bus does not support) to the uncached
+        // mapping, the barrier makes sure they have all completed before the cores are started
+        for(size_t i = 0; i< size; i++){
+            rom[i] = program[i];
+        }
+        bus_write_barrier();
+        return;
+    }
+    for(size_t i = 0; i< size; i++){
+        rom[i] = program[i];
+        usleep(1);
+    }
+}
+
+void mmap_bus_backend::map_region(uint64_t address, uint64_t size) {
+    control_bus->map_region(address, size);
+}
@@ -0,0 +1,59 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+#include "hw_interface/bus/recording_bus_backend.hpp"
+
+/// Create a proxy that forwards all the transactions to another backend while keeping a timestamped log of them
+/// \param target Backend the transactions are forwarded to
+recording_bus_backend::recording_bus_backend(std::shared_ptr<bus_backend> target) : target(std::move(target)) {
+    epoch = std::chrono::steady_clock::now();
+}
+
+void recording_bus_backend::write_register(uint64_t address, uint32_t value) {
+    record({now(), address, value, control_plane_write});
+    target->write_register(address, value);
+}
+
+uint32_t recording_bus_backend::read_register(uint64_t address) {
+    auto timestamp = now();
+    auto value = target->read_register(address);
+    record({timestamp, address, value, control_plane_read});
+    return value;
+}
+
+void recording_bus_backend::load_program(uint64_t address, const uint32_t *program, size_t size) {
+    auto timestamp = now();
+    for(size_t i = 0; i<size; i++){
+        record({timestamp, address + 4*i, program[i], rom_plane_write});
+    }
+    target->load_program(address, program, size);
+}
+
+/// Stream the transactions to a trace file instead of keeping them in memory
+/// \param w Writer for the trace file, pass nullptr to go back to in memory recording
+void recording_bus_backend::set_trace_writer(std::shared_ptr<bus_trace_writer> w) {
+    writer = std::move(w);
+}
+
+uint64_t recording_bus_backend::now() const {
+    auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch);
+    return timestamp.count();
+}
+
+void recording_bus_backend::record(const bus_transaction &t) {
+    if(writer){
+        writer->append(t);
+    } else {
+        transactions.push_back(t);
+    }
+}
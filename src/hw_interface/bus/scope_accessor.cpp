@@ -14,29 +14,102 @@
 
 #include "hw_interface/bus/scope_accessor.hpp"
 
-scope_accessor::scope_accessor() {
+/// Open the scope data device
+/// \param n_channels Number of channels of the scope
+/// \param buffer_size Configured number of samples per channel in each frame, overridden by the size reported by the
+/// kernel module when it supports the query and the reported buffer holds a whole number of samples for every channel
+scope_accessor::scope_accessor(uint32_t n_channels, uint32_t buffer_size) : n_channels(n_channels), buffer_size(buffer_size) {
     std::string data_file = if_dict.get_data_bus();
     fd_data = open(data_file.c_str(), O_RDWR| O_SYNC);
     if(fd_data == -1){
         spdlog::error("Error while mapping the scope data buffer: {0}", std::strerror(errno));
+        return;
     }
 
+    auto dma_bytes = ioctl(fd_data, ioctl_get_buffer_size);
+    if(dma_bytes <= 0) {
+        spdlog::info("The kernel module does not report the scope buffer size, using the configured {0} samples per channel", buffer_size);
+    } else if(n_channels > 0){
+        if(dma_bytes % (sizeof(uint64_t)*n_channels) != 0){
+            spdlog::error("The {0} bytes scope buffer reported by the kernel module can not be split evenly among {1} channels, "
+                          "keeping the configured size of {2} samples per channel", dma_bytes, n_channels, buffer_size);
+        } else {
+            auto discovered = static_cast<uint32_t>(dma_bytes/sizeof(uint64_t)/n_channels);
+            if(discovered != buffer_size) spdlog::info("Scope buffer size discovered from the kernel module: {0} samples", discovered);
+            this->buffer_size = discovered;
+        }
+    }
+    spdlog::info("Scope geometry: {0} channels, {1} samples per channel", this->n_channels, this->buffer_size);
+
+    // The DMA buffer can optionally be mapped read only, so that frames are decoded in place instead of being copied
+    // out of the kernel on every read
+    auto t = getenv("SCOPE_DATA_MMAP");
+    if(t == nullptr || std::string(t) == "0") return;
+
+    auto map = mmap(nullptr, get_frame_words()*sizeof(uint64_t), PROT_READ, MAP_SHARED, fd_data, 0);
+    if(map == MAP_FAILED){
+        spdlog::error("Error while mapping the scope DMA buffer, falling back to read(): {0}", std::strerror(errno));
+        return;
+    }
+    mapped_data = static_cast<const uint64_t *>(map);
+    spdlog::info("The scope DMA buffer is mapped read only");
 }
 
 scope_accessor::~scope_accessor() {
+    if(mapped_data != nullptr) munmap(const_cast<uint64_t *>(mapped_data), get_frame_words()*sizeof(uint64_t));
     close(fd_data);
 }
 
-std::array<uint64_t, scope_accessor::n_channels*scope_accessor::buffer_size>  scope_accessor::get_scope_data() {
-
-    std::array<uint64_t, n_channels*buffer_size> ret_val{};
-    auto read_size = ret_val.size()*sizeof(uint64_t);
-    ssize_t read_data = read(fd_data,ret_val.data(), read_size);
-    if(read_data==0) throw std::runtime_error("nothing to read");
+/// Copy the latest frame from the kernel straight into a caller provided buffer
+/// \param buffer Destination of the packed scope words
+/// \return Number of words transferred, 0 if no data is available
+size_t scope_accessor::read_scope_data(std::span<uint64_t> buffer) {
+    ssize_t read_data = read(fd_data, buffer.data(), buffer.size_bytes());
     if(read_data<0) {
         spdlog::critical(std::strerror(errno));
+        return 0;
     }
-    spdlog::trace("READ_DATA: COPIED DATA FROM KERNEL ({0} words transferred)", read_data/sizeof(uint64_t));
-    return ret_val;
+    HOT_LOG_TRACE("READ_DATA: COPIED DATA FROM KERNEL ({0} words transferred)", read_data/sizeof(uint64_t));
+    return read_data/sizeof(uint64_t);
+}
+
+/// Check whether the DMA engine completed a transfer since the last frame was claimed
+/// \return true if a new frame is in the DMA buffer
+bool scope_accessor::new_data_available() {
+    return ioctl(fd_data, ioctl_new_data_available) > 0;
 }
 
+/// Take ownership of the frame currently in the mapped DMA buffer. The new data flag is cleared with a zero length
+/// read, so that a transfer completing while the frame is being decoded raises it again and can be detected with
+/// new_data_available()
+/// \return false if no new frame is available
+bool scope_accessor::claim_mapped_frame() {
+    if(!new_data_available()) return false;
+    if(read(fd_data, nullptr, 0) < 0) {
+        spdlog::critical(std::strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+/// Block until the DMA engine signals a new frame. The device is polled for readiness, while the frame ownership is
+/// always decided by the new data flag, as some versions of the module report the device as readable at all times
+/// \param timeout Maximum time to wait, clamped to max_wait_timeout
+/// \return false if no new frame arrived before the timeout expired
+bool scope_accessor::wait_for_data(std::chrono::milliseconds timeout) {
+    timeout = std::clamp(timeout, std::chrono::milliseconds::zero(), max_wait_timeout);
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    pollfd pfd{fd_data, POLLIN, 0};
+    while(true){
+        if(new_data_available()) return true;
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if(remaining.count() <= 0) return false;
+        auto ready = poll(&pfd, 1, static_cast<int>(remaining.count()));
+        if(ready < 0 && errno != EINTR) {
+            spdlog::critical(std::strerror(errno));
+            return false;
+        }
+        // readable without a new frame: back off instead of spinning on the poll
+        if(ready > 0 && !new_data_available()) usleep(100);
+    }
+}
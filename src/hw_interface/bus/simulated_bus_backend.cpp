@@ -0,0 +1,51 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "hw_interface/bus/simulated_bus_backend.hpp"
+
+void simulated_bus_backend::write_register(uint64_t address, uint32_t value) {
+    wait_access();
+    registers[address] = value;
+}
+
+uint32_t simulated_bus_backend::read_register(uint64_t address) {
+    wait_access();
+    auto reg = registers.find(address);
+    return reg == registers.end() ? 0 : reg->second;
+}
+
+void simulated_bus_backend::load_program(uint64_t address, const uint32_t *program, size_t size) {
+    for(size_t i = 0; i<size; i++){
+        wait_access();
+        rom[address + 4*i] = program[i];
+    }
+}
+
+uint32_t simulated_bus_backend::peek_register(uint64_t address) const {
+    auto reg = registers.find(address);
+    return reg == registers.end() ? 0 : reg->second;
+}
+
+uint32_t simulated_bus_backend::peek_rom(uint64_t address) const {
+    auto word = rom.find(address);
+    return word == rom.end() ? 0 : word->second;
+}
+
+/// Emulate the latency of a bus transaction, spinning instead of sleeping as the delays of interest are well below
+/// the scheduler resolution
+void simulated_bus_backend::wait_access() const {
+    if(access_latency.count() == 0) return;
+    auto deadline = std::chrono::steady_clock::now() + access_latency;
+    while(std::chrono::steady_clock::now() < deadline);
+}
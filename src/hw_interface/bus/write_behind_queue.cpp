@@ -0,0 +1,62 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <algorithm>
+#include <bit>
+
+#include "hw_interface/bus/write_behind_queue.hpp"
+
+/// \param capacity Number of writes that can be queued, rounded up to the next power of two
+write_behind_queue::write_behind_queue(size_t capacity) : slots(std::bit_ceil(std::max<size_t>(capacity, 2))) {
+    mask = slots.size() - 1;
+    for(size_t i = 0; i<slots.size(); i++){
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+/// Enqueue a write, can be called from any thread
+/// \param w Write to enqueue
+/// \return false if the queue is full
+bool write_behind_queue::try_push(const queued_write &w) {
+    auto pos = enqueue_pos.load(std::memory_order_relaxed);
+    while(true){
+        auto &s = slots[pos & mask];
+        auto seq = s.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if(diff == 0){
+            if(enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)){
+                s.write = w;
+                s.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if(diff < 0){
+            return false;
+        } else {
+            pos = enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+/// Dequeue the oldest write, must only be called from the consumer thread
+/// \param w Dequeued write
+/// \return false if the queue is empty
+bool write_behind_queue::try_pop(queued_write &w) {
+    auto &s = slots[dequeue_pos & mask];
+    auto seq = s.sequence.load(std::memory_order_acquire);
+    if(static_cast<intptr_t>(seq) - static_cast<intptr_t>(dequeue_pos + 1) < 0) return false;
+    w = s.write;
+    s.sequence.store(dequeue_pos + mask + 1, std::memory_order_release);
+    dequeue_pos++;
+    return true;
+}
@@ -0,0 +1,132 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "hw_interface/fft_plan.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <numbers>
+
+// std::complex multiplication checks for infinities and NaNs, the plain formula is all the transforms need
+static inline std::complex<float> mul(std::complex<float> a, std::complex<float> b) {
+    return {a.real()*b.real() - a.imag()*b.imag(), a.real()*b.imag() + a.imag()*b.real()};
+}
+
+static std::complex<float> unit_phasor(double angle) {
+    return {static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle))};
+}
+
+fft_plan::fft_plan(size_t n) : n(n) {
+    if(n <= 1) return;
+    if(std::has_single_bit(n)){
+        auto bits = std::countr_zero(n);
+        bit_reversal.resize(n);
+        for(size_t i = 1; i<n; i++) bit_reversal[i] = (bit_reversal[i >> 1] >> 1) | static_cast<uint32_t>((i & 1) << (bits - 1));
+        twiddles.resize(n/2);
+        for(size_t k = 0; k<n/2; k++) twiddles[k] = unit_phasor(-2.0*std::numbers::pi*static_cast<double>(k)/static_cast<double>(n));
+    } else {
+        // X_k = w_k * sum_j (x_j w_j) conj(w_{k-j}), with w_k = exp(-i pi k^2 / n): a circular convolution of
+        // length m >= 2n-1 computed with power of two transforms
+        auto m = std::bit_ceil(2*n - 1);
+        inner = std::make_unique<fft_plan>(m);
+        chirp.resize(n);
+        for(size_t k = 0; k<n; k++){
+            // k^2 mod 2n keeps the angle small, and the phasor exact, for long transforms
+            auto k2 = (static_cast<uint64_t>(k)*k) % (2*n);
+            chirp[k] = unit_phasor(-std::numbers::pi*static_cast<double>(k2)/static_cast<double>(n));
+        }
+        chirp_spectrum.assign(m, {0, 0});
+        chirp_spectrum[0] = std::conj(chirp[0]);
+        for(size_t k = 1; k<n; k++){
+            chirp_spectrum[k] = std::conj(chirp[k]);
+            chirp_spectrum[m - k] = std::conj(chirp[k]);
+        }
+        inner->forward(chirp_spectrum.data());
+        scratch.resize(m);
+    }
+}
+
+/// Transform data in place, without normalization
+/// \param data Array of size() complex samples
+void fft_plan::forward(std::complex<float> *data) {
+    if(n <= 1) return;
+    if(inner) bluestein(data);
+    else radix2(data);
+}
+
+void fft_plan::radix2(std::complex<float> *data) {
+    for(size_t i = 0; i<n; i++){
+        auto j = bit_reversal[i];
+        if(i < j) std::swap(data[i], data[j]);
+    }
+    for(size_t len = 2; len<=n; len <<= 1){
+        auto half = len/2;
+        auto step = n/len;
+        for(size_t i = 0; i<n; i += len){
+            for(size_t j = 0; j<half; j++){
+                auto u = data[i + j];
+                auto v = mul(data[i + j + half], twiddles[j*step]);
+                data[i + j] = u + v;
+                data[i + j + half] = u - v;
+            }
+        }
+    }
+}
+
+void fft_plan::bluestein(std::complex<float> *data) {
+    auto m = scratch.size();
+    for(size_t k = 0; k<n; k++) scratch[k] = mul(data[k], chirp[k]);
+    std::fill(scratch.begin() + static_cast<ptrdiff_t>(n), scratch.end(), std::complex<float>(0, 0));
+    inner->forward(scratch.data());
+    // inverse transform of the product through the conjugation identity ifft(y) = conj(fft(conj(y)))/m
+    for(size_t k = 0; k<m; k++) scratch[k] = std::conj(mul(scratch[k], chirp_spectrum[k]));
+    inner->forward(scratch.data());
+    auto scale = 1.0f/static_cast<float>(m);
+    for(size_t k = 0; k<n; k++) data[k] = mul(std::conj(scratch[k])*scale, chirp[k]);
+}
+
+real_fft_plan::real_fft_plan(size_t n) : n(n), plan(n%2 == 0 ? n/2 : n) {
+    if(n%2 == 0){
+        twiddles.resize(n/2 + 1);
+        for(size_t k = 0; k<=n/2; k++) twiddles[k] = unit_phasor(-2.0*std::numbers::pi*static_cast<double>(k)/static_cast<double>(n));
+        buffer.resize(n/2);
+    } else {
+        buffer.resize(n);
+    }
+}
+
+/// Transform a real signal
+/// \param input Array of size() real samples
+/// \param output Array receiving the n_bins() bins from DC to Nyquist
+void real_fft_plan::forward(const float *input, std::complex<float> *output) {
+    if(n == 0) return;
+    if(n%2){
+        for(size_t i = 0; i<n; i++) buffer[i] = {input[i], 0};
+        plan.forward(buffer.data());
+        std::copy_n(buffer.begin(), n_bins(), output);
+        return;
+    }
+    auto h = n/2;
+    for(size_t i = 0; i<h; i++) buffer[i] = {input[2*i], input[2*i + 1]};
+    plan.forward(buffer.data());
+    // split the half length spectrum in the spectra of the even and odd samples, then recombine them
+    for(size_t k = 0; k<=h; k++){
+        auto zk = buffer[k%h];
+        auto zc = std::conj(buffer[(h - k)%h]);
+        auto even = (zk + zc)*0.5f;
+        auto odd = (zk - zc)*std::complex<float>(0, -0.5f);
+        output[k] = even + mul(twiddles[k], odd);
+    }
+}
@@ -51,6 +51,9 @@ responses::response_code fpga_bridge::load_bitstream(const std::vector<uint8_t>&
     auto driver = if_dict.get_fpga_bitstream_if();
     const int fd = open(driver.c_str(), O_RDWR);
 
+    // the queued writes are issued on the old fabric, then the bus is held until the new one is up
+    auto bus = busses->quiesce();
+
     write(fd, bitstream.data(), bitstream.size());
 
     spdlog::warn("LOAD BITSTREAM: written file");
@@ -149,20 +152,171 @@ responses::response_code fpga_bridge::set_scope_data(uint64_t addr) {
 }
 
 void fpga_bridge::write_direct(uint64_t addr, uint32_t val) {
-    spdlog::info("WRITE SINGLE REGISTER (DIRECT): addr 0x{0:x} value {1}", addr, val);
-    if(fpga_loaded) busses->write_register({addr}, val);
+    HOT_LOG_INFO("WRITE SINGLE REGISTER (DIRECT): addr 0x{0:x} value {1}", addr, val);
+    if(fpga_loaded) busses->write_register(addr, val);
+}
+
+/// Write a group of registers in order, as a single bus transaction
+/// \param writes Address and value of each write
+void fpga_bridge::write_block(std::span<const std::pair<uint64_t, uint32_t>> writes) {
+    HOT_LOG_INFO("WRITE REGISTER BLOCK (DIRECT): {0} registers", writes.size());
+    if(fpga_loaded) busses->write_registers(writes);
 }
 
 void fpga_bridge::write_proxied(uint64_t proxy_addr, uint32_t target_addr, uint32_t val) {
-    spdlog::info("WRITE SINGLE REGISTER (AXIS PROXIED): proxy_addr 0x{0:x} addr 0x{1:x} value {2}",proxy_addr, target_addr, val);
-    if(fpga_loaded) busses->write_register({target_addr, proxy_addr}, val);
+    HOT_LOG_INFO("WRITE SINGLE REGISTER (AXIS PROXIED): proxy_addr 0x{0:x} addr 0x{1:x} value {2}",proxy_addr, target_addr, val);
+    if(fpga_loaded) busses->write_proxied(proxy_addr, target_addr, val);
 }
 
 uint32_t fpga_bridge::read_direct(uint64_t address) {
-    spdlog::info("READ SINGLE REGISTER (DIRECT): addr 0x{0:x}", address);
+    HOT_LOG_INFO("READ SINGLE REGISTER (DIRECT): addr 0x{0:x}", address);
+    if(!fpga_loaded) return 0;
+    return busses->read_register(address);
+}
+
+/// Read a group of registers in a single locked pass
+/// \param addresses Addresses of the registers to read
+/// \return Values of the registers, in the same order as the addresses
+std::vector<uint32_t> fpga_bridge::read_snapshot(const std::vector<uint64_t> &addresses) {
+    spdlog::trace("READ REGISTER SNAPSHOT: {0} registers", addresses.size());
+    if(!fpga_loaded) return std::vector<uint32_t>(addresses.size(), 0);
+    return busses->read_registers(addresses);
+}
+
+/// Read a group of registers for monitoring purposes, without logging or recording the access
+/// \param addresses Addresses of the registers to read
+/// \param values Vector where the values are placed, it must be as large as the addresses one
+/// \return false if the FPGA is not loaded and no read took place
+bool fpga_bridge::sample_registers(const std::vector<uint64_t> &addresses, std::vector<uint32_t> &values) const {
+    if(!fpga_loaded) return false;
+    busses->sample_registers(addresses, values);
+    return true;
+}
+
+/// Read-modify-write a register in a single bus transaction, updating only the masked bits
+/// \param address Address of the register to modify
+/// \param mask Bits of the register to update
+/// \param value New value of the masked bits
+/// \return Value of the register after the modification
+uint32_t fpga_bridge::modify_register(uint64_t address, uint32_t mask, uint32_t value) {
+    spdlog::info("MODIFY SINGLE REGISTER: addr 0x{0:x} mask 0x{1:x} value 0x{2:x}", address, mask, value);
     if(!fpga_loaded) return 0;
-    std::vector<uint64_t> a= {address};
-    return busses->read_register(a);
+    return busses->modify_register(address, mask, value);
+}
+
+/// Wait for the masked value of a register to match an expected value
+/// \param address Address of the register to poll
+/// \param mask Bits of the register to check
+/// \param expected Expected value of the masked bits
+/// \param timeout Maximum time to wait for the condition
+/// \param value Last value read from the register
+/// \return true if the condition was met before the timeout expired
+bool fpga_bridge::wait_for(uint64_t address, uint32_t mask, uint32_t expected, std::chrono::nanoseconds timeout, uint32_t &value) {
+    spdlog::info("WAIT FOR REGISTER: addr 0x{0:x} mask 0x{1:x} expected 0x{2:x} timeout {3} us", address, mask, expected,
+                 std::chrono::duration_cast<std::chrono::microseconds>(timeout).count());
+    value = 0;
+    if(!fpga_loaded) return false;
+    return busses->wait_for(address, mask, expected, timeout, value);
+}
+
+/// Discard the shadow copy of the idempotent registers, forcing the next write to each of them to reach the hardware
+/// \return #RESP_OK
+/// Wait for all the queued register writes to reach the hardware
+/// \return #RESP_OK
+responses::response_code fpga_bridge::flush_bus() const {
+    spdlog::trace("FLUSH BUS");
+    busses->flush();
+    return responses::ok;
+}
+
+responses::response_code fpga_bridge::invalidate_register_cache() const {
+    spdlog::info("INVALIDATE REGISTER CACHE");
+    busses->invalidate_shadow();
+    return responses::ok;
+}
+
+/// Start capturing all the bus transactions to a binary trace file in the traces directory
+/// \param name Name of the trace file, it can not contain any path component
+/// \return #RESP_OK on success, invalid_arg for an invalid name, driver_file_not_found if the file can not be created
+responses::response_code fpga_bridge::start_bus_trace(const std::string &name) const {
+    spdlog::info("START BUS TRACE: {0}", name);
+    if(!bus_trace_writer::is_valid_name(name)) return responses::invalid_arg;
+
+    std::error_code ec;
+    std::filesystem::create_directories(runtime_config.traces_dir, ec);
+    auto path = std::filesystem::path(runtime_config.traces_dir) / name;
+    if(!busses->start_trace(path.string())) return responses::driver_file_not_found;
+    return responses::ok;
+}
+
+/// Stop the bus trace in progress
+/// \return Response with the number of captured transactions
+nlohmann::json fpga_bridge::stop_bus_trace() const {
+    auto n_transactions = busses->stop_trace();
+    spdlog::info("STOP BUS TRACE: {0} transactions captured", n_transactions);
+    nlohmann::json resp;
+    resp["response_code"] = responses::as_integer(responses::ok);
+    resp["data"] = n_transactions;
+    return resp;
+}
+
+/// Collect the per region bus statistics
+/// \param enable Whether the statistics should be collected from now on
+/// \param reset true to clear the counters after reading them
+/// \return Counters for each bus region
+nlohmann::json fpga_bridge::get_bus_stats(bool enable, bool reset) const {
+    nlohmann::json regions = nlohmann::json::array();
+    for(auto &r:busses->get_stats()){
+        nlohmann::json region;
+        region["name"] = r.name;
+        region["base"] = r.base;
+        region["size"] = r.size;
+        region["reads"] = r.stats.reads;
+        region["writes"] = r.stats.writes;
+        region["bytes"] = r.stats.bytes;
+        region["lock_hold_ns"] = r.stats.lock_hold_ns;
+        region["max_lock_wait_ns"] = r.stats.max_lock_wait_ns;
+        regions.push_back(region);
+    }
+    if(reset) busses->reset_stats();
+    if(enable != busses->stats_enabled()) busses->enable_stats(enable);
+
+    nlohmann::json ret;
+    ret["enabled"] = enable;
+    ret["regions"] = regions;
+    return ret;
+}
+
+/// Replay a bus trace from the traces directory against the current bus backend
+/// \param name Name of the trace file, it can not contain any path component
+/// \param original_timing true to reproduce the original timing, false to replay as fast as possible
+/// \return Response with the replay statistics
+nlohmann::json fpga_bridge::replay_bus_trace(const std::string &name, bool original_timing) const {
+    spdlog::info("REPLAY BUS TRACE: {0} ({1})", name, original_timing ? "original timing" : "as fast as possible");
+    nlohmann::json resp;
+    if(!fpga_loaded){
+        resp["response_code"] = responses::as_integer(responses::bus_access_error);
+        resp["data"] = "DRIVER ERROR: A bitstream must be loaded before replaying a bus trace";
+        return resp;
+    }
+    if(!bus_trace_writer::is_valid_name(name)){
+        resp["response_code"] = responses::as_integer(responses::invalid_arg);
+        resp["data"] = "DRIVER ERROR: Invalid bus trace name " + name;
+        return resp;
+    }
+    auto path = std::filesystem::path(runtime_config.traces_dir) / name;
+    bus_replay_report report;
+    if(!busses->replay_trace(path.string(), original_timing, report)){
+        resp["response_code"] = responses::as_integer(responses::driver_file_not_found);
+        resp["data"] = "DRIVER ERROR: Unable to load the bus trace " + name;
+        return resp;
+    }
+    resp["response_code"] = responses::as_integer(responses::ok);
+    resp["data"]["n_transactions"] = report.n_transactions;
+    resp["data"]["trace_duration"] = report.trace_duration;
+    resp["data"]["replay_duration"] = report.replay_duration;
+    resp["data"]["throughput"] = report.throughput;
+    return resp;
 }
 
 uint32_t fpga_bridge::get_pl_clock( uint8_t clk_n) {
@@ -197,6 +351,10 @@ std::vector<bus_op> fpga_bridge::get_bus_operations() const {
     return busses->get_operations();
 }
 
-std::pair<std::string, std::string> fpga_bridge::get_hardware_simulation_data() const {
-    return busses->get_hardware_simulation_data();
+std::pair<std::string, std::string> fpga_bridge::get_hardware_simulation_data(hw_sim_format format) const {
+    return busses->get_hardware_simulation_data(format);
+}
+
+bool fpga_bridge::write_hardware_simulation_data(const std::string &rom_path, const std::string &control_path, hw_sim_format format) const {
+    return busses->write_hardware_simulation_data(rom_path, control_path, format);
 }
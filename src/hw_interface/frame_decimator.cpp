@@ -0,0 +1,176 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+    #define FRAME_DECIMATOR_SSE
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define FRAME_DECIMATOR_NEON
+#endif
+
+#include "hw_interface/frame_decimator.hpp"
+
+// SSE2 and NEON are part of the baseline of the x86_64 and aarch64 targets, so unlike the frame decoder kernels no
+// runtime selection is needed here
+static void bucket_extrema(const float *data, size_t n, float &min_out, float &max_out) {
+    float mn = data[0];
+    float mx = data[0];
+    size_t i = 0;
+#if defined(FRAME_DECIMATOR_SSE)
+    if(n >= 4){
+        __m128 vmin = _mm_loadu_ps(data);
+        __m128 vmax = vmin;
+        for(i = 4; i + 4 <= n; i += 4){
+            __m128 v = _mm_loadu_ps(data + i);
+            vmin = _mm_min_ps(v, vmin);
+            vmax = _mm_max_ps(v, vmax);
+        }
+        alignas(16) float lanes_min[4];
+        alignas(16) float lanes_max[4];
+        _mm_store_ps(lanes_min, vmin);
+        _mm_store_ps(lanes_max, vmax);
+        mn = *std::min_element(lanes_min, lanes_min + 4);
+        mx = *std::max_element(lanes_max, lanes_max + 4);
+    }
+#elif defined(FRAME_DECIMATOR_NEON)
+    if(n >= 4){
+        float32x4_t vmin = vld1q_f32(data);
+        float32x4_t vmax = vmin;
+        for(i = 4; i + 4 <= n; i += 4){
+            float32x4_t v = vld1q_f32(data + i);
+            vmin = vminq_f32(v, vmin);
+            vmax = vmaxq_f32(v, vmax);
+        }
+        float lanes_min[4];
+        float lanes_max[4];
+        vst1q_f32(lanes_min, vmin);
+        vst1q_f32(lanes_max, vmax);
+        mn = *std::min_element(lanes_min, lanes_min + 4);
+        mx = *std::max_element(lanes_max, lanes_max + 4);
+    }
+#endif
+    for(; i<n; i++){
+        mn = std::min(mn, data[i]);
+        mx = std::max(mx, data[i]);
+    }
+    min_out = mn;
+    max_out = mx;
+}
+
+std::optional<decimation_mode> frame_decimator::parse_mode(const std::string &mode) {
+    if(mode == "none") return decimation_mode::none;
+    if(mode == "minmax") return decimation_mode::minmax;
+    if(mode == "lttb") return decimation_mode::lttb;
+    return std::nullopt;
+}
+
+/// Decimate a channel, the result is available through get_values() and get_indices() until the next call
+/// \param mode Decimation algorithm
+/// \param samples Samples of the channel
+/// \param max_points Maximum number of points to keep, at least 3
+/// \return Number of points kept
+size_t frame_decimator::decimate(decimation_mode mode, std::span<const float> samples, size_t max_points) {
+    max_points = std::max<size_t>(max_points, 3);
+    if(values.size() < std::min(samples.size(), max_points)){
+        values.resize(std::min(samples.size(), max_points));
+        indices.resize(values.size());
+    }
+    n_points = 0;
+    if(mode == decimation_mode::none || samples.size() <= max_points) {
+        if(values.size() < samples.size()){
+            values.resize(samples.size());
+            indices.resize(samples.size());
+        }
+        passthrough(samples);
+    } else if(mode == decimation_mode::minmax) {
+        minmax(samples, max_points);
+    } else {
+        lttb(samples, max_points);
+    }
+    return n_points;
+}
+
+void frame_decimator::passthrough(std::span<const float> samples) {
+    for(size_t i = 0; i<samples.size(); i++) push(samples, i);
+}
+
+void frame_decimator::minmax(std::span<const float> samples, size_t max_points) {
+    auto n = samples.size();
+    auto n_buckets = max_points/2;
+    for(size_t b = 0; b<n_buckets; b++){
+        size_t start = b*n/n_buckets;
+        size_t end = (b + 1)*n/n_buckets;
+        if(start == end) continue;
+        auto bucket = samples.subspan(start, end - start);
+        float mn, mx;
+        bucket_extrema(bucket.data(), bucket.size(), mn, mx);
+        // the extrema are looked up again to emit them in order of occurrence, NaNs fall back to the bucket start
+        auto i_min = start;
+        auto i_max = start;
+        if(auto it = std::ranges::find(bucket, mn); it != bucket.end()) i_min = start + (it - bucket.begin());
+        if(auto it = std::ranges::find(bucket, mx); it != bucket.end()) i_max = start + (it - bucket.begin());
+        if(i_min == i_max) {
+            push(samples, i_min);
+        } else {
+            push(samples, std::min(i_min, i_max));
+            push(samples, std::max(i_min, i_max));
+        }
+    }
+}
+
+void frame_decimator::lttb(std::span<const float> samples, size_t max_points) {
+    auto n = samples.size();
+    auto n_buckets = max_points - 2;
+    double bucket_size = static_cast<double>(n - 2)/static_cast<double>(n_buckets);
+
+    size_t a = 0;
+    push(samples, a);
+    for(size_t b = 0; b<n_buckets; b++){
+        auto start = static_cast<size_t>(std::floor(b*bucket_size)) + 1;
+        auto end = std::min(static_cast<size_t>(std::floor((b + 1)*bucket_size)) + 1, n - 1);
+        auto next_start = end;
+        auto next_end = std::min(static_cast<size_t>(std::floor((b + 2)*bucket_size)) + 1, n);
+        if(b == n_buckets - 1) {
+            next_start = n - 1;
+            next_end = n;
+        }
+
+        double sum_y = 0;
+        for(size_t j = next_start; j<next_end; j++) sum_y += samples[j];
+        auto avg_x = static_cast<float>(next_start + next_end - 1)/2.0f;
+        auto avg_y = static_cast<float>(sum_y/static_cast<double>(next_end - next_start));
+
+        // twice the triangle area is an affine function of the candidate point: |k_y*(y - a_y) + k_x*(x - a_x)|
+        auto a_x = static_cast<float>(a);
+        auto a_y = samples[a];
+        auto k_y = a_x - avg_x;
+        auto k_x = avg_y - a_y;
+        float max_area = -1.0f;
+        auto selected = start;
+        for(size_t j = start; j<end; j++){
+            auto area = std::abs(k_y*(samples[j] - a_y) + k_x*(static_cast<float>(j) - a_x));
+            if(area > max_area){
+                max_area = area;
+                selected = j;
+            }
+        }
+        a = selected;
+        push(samples, a);
+    }
+    push(samples, n - 1);
+}
@@ -0,0 +1,358 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+    #define FRAME_DECODER_X86
+#endif
+
+#if defined(__ARM_NEON)
+    #include <arm_neon.h>
+    #define FRAME_DECODER_NEON
+#endif
+
+#include "hw_interface/frame_decoder.hpp"
+
+// All the kernels must produce bit identical results. The samples are at most 23 bits wide, so their conversion to
+// float is always exact, and the only rounding happens in the single precision multiplication by the scaling factor,
+// which is performed with the same IEEE semantics in all the kernels.
+
+static void decode_scalar(const uint64_t *words, size_t n_words, const float *scaling_factors, uint32_t n_channels,
+                          uint32_t *channels, float *values) {
+    for(size_t i = 0; i<n_words; i++){
+        auto word = words[i];
+        uint32_t raw = word & 0xffffffff;
+        uint32_t channel = (word>>32) & 0xffff;
+        uint32_t metadata = word>>48;
+
+        uint32_t size = (metadata & 0xf) + 8;
+        uint32_t sample = raw & ((1U<<size) - 1);
+        if(metadata & 0x10){
+            uint32_t sign_bit = 1U<<(size - 1);
+            sample = (sample ^ sign_bit) - sign_bit;
+        }
+        float value = scaling_factors[std::min(channel, n_channels)]*(float)static_cast<int32_t>(sample);
+        if(metadata & 0x20) std::memcpy(&value, &raw, sizeof(float));
+
+        channels[i] = channel;
+        values[i] = value;
+    }
+}
+
+#ifdef FRAME_DECODER_X86
+
+static void decode_sse2(const uint64_t *words, size_t n_words, const float *scaling_factors, uint32_t n_channels,
+                        uint32_t *channels, float *values) {
+    const __m128i channel_mask = _mm_set1_epi32(0xffff);
+    const __m128i size_mask = _mm_set1_epi32(0xf);
+    const __m128i signed_flag = _mm_set1_epi32(0x10);
+    const __m128i float_flag = _mm_set1_epi32(0x20);
+    const __m128i one = _mm_set1_epi32(1);
+
+    size_t i = 0;
+    for(; i + 4 <= n_words; i += 4){
+        auto a = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(words + i)));
+        auto b = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(words + i + 2)));
+        auto raw = _mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+        auto high = _mm_castps_si128(_mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+
+        auto channel = _mm_and_si128(high, channel_mask);
+        auto metadata = _mm_srli_epi32(high, 16);
+
+        // SSE2 has no per lane shifts, 1<<size is built by placing size in the exponent of a float
+        auto size = _mm_add_epi32(_mm_and_si128(metadata, size_mask), _mm_set1_epi32(8));
+        auto pow2 = _mm_cvttps_epi32(_mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(size, _mm_set1_epi32(127)), 23)));
+        auto sample = _mm_and_si128(raw, _mm_sub_epi32(pow2, one));
+        auto sign_bit = _mm_srli_epi32(pow2, 1);
+        auto extended = _mm_sub_epi32(_mm_xor_si128(sample, sign_bit), sign_bit);
+        auto is_signed = _mm_cmpeq_epi32(_mm_and_si128(metadata, signed_flag), signed_flag);
+        sample = _mm_or_si128(_mm_and_si128(is_signed, extended), _mm_andnot_si128(is_signed, sample));
+
+        auto clamped = _mm_set1_epi32(static_cast<int>(n_channels));
+        auto in_range = _mm_cmplt_epi32(channel, clamped);
+        auto scaling = _mm_andnot_ps(_mm_castsi128_ps(in_range), _mm_set1_ps(scaling_factors[n_channels]));
+        for(uint32_t c = 0; c<n_channels; c++){
+            auto selected = _mm_castsi128_ps(_mm_cmpeq_epi32(channel, _mm_set1_epi32(static_cast<int>(c))));
+            scaling = _mm_or_ps(scaling, _mm_and_ps(selected, _mm_set1_ps(scaling_factors[c])));
+        }
+        auto value = _mm_mul_ps(scaling, _mm_cvtepi32_ps(sample));
+
+        auto is_float = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(metadata, float_flag), float_flag));
+        value = _mm_or_ps(_mm_and_ps(is_float, _mm_castsi128_ps(raw)), _mm_andnot_ps(is_float, value));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(channels + i), channel);
+        _mm_storeu_ps(values + i, value);
+    }
+    decode_scalar(words + i, n_words - i, scaling_factors, n_channels, channels + i, values + i);
+}
+
+__attribute__((target("avx2")))
+static void decode_avx2(const uint64_t *words, size_t n_words, const float *scaling_factors, uint32_t n_channels,
+                        uint32_t *channels, float *values) {
+    const __m256i channel_mask = _mm256_set1_epi32(0xffff);
+    const __m256i size_mask = _mm256_set1_epi32(0xf);
+    const __m256i signed_flag = _mm256_set1_epi32(0x10);
+    const __m256i float_flag = _mm256_set1_epi32(0x20);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i max_channel = _mm256_set1_epi32(static_cast<int>(n_channels));
+
+    size_t i = 0;
+    for(; i + 8 <= n_words; i += 8){
+        auto a = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + i)));
+        auto b = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(words + i + 4)));
+        // the shuffles work within 128 bit lanes, the permutation restores the order of the words
+        auto raw = _mm256_permute4x64_epi64(_mm256_castps_si256(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))), _MM_SHUFFLE(3, 1, 2, 0));
+        auto high = _mm256_permute4x64_epi64(_mm256_castps_si256(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1))), _MM_SHUFFLE(3, 1, 2, 0));
+
+        auto channel = _mm256_and_si256(high, channel_mask);
+        auto metadata = _mm256_srli_epi32(high, 16);
+
+        auto size = _mm256_add_epi32(_mm256_and_si256(metadata, size_mask), _mm256_set1_epi32(8));
+        auto pow2 = _mm256_sllv_epi32(one, size);
+        auto sample = _mm256_and_si256(raw, _mm256_sub_epi32(pow2, one));
+        auto sign_bit = _mm256_srli_epi32(pow2, 1);
+        auto extended = _mm256_sub_epi32(_mm256_xor_si256(sample, sign_bit), sign_bit);
+        auto is_signed = _mm256_cmpeq_epi32(_mm256_and_si256(metadata, signed_flag), signed_flag);
+        sample = _mm256_blendv_epi8(sample, extended, is_signed);
+
+        auto scaling = _mm256_i32gather_ps(scaling_factors, _mm256_min_epu32(channel, max_channel), 4);
+        auto value = _mm256_mul_ps(scaling, _mm256_cvtepi32_ps(sample));
+
+        auto is_float = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(metadata, float_flag), float_flag));
+        value = _mm256_blendv_ps(value, _mm256_castsi256_ps(raw), is_float);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(channels + i), channel);
+        _mm256_storeu_ps(values + i, value);
+    }
+    decode_scalar(words + i, n_words - i, scaling_factors, n_channels, channels + i, values + i);
+}
+
+#endif
+
+#ifdef FRAME_DECODER_NEON
+
+static void decode_neon(const uint64_t *words, size_t n_words, const float *scaling_factors, uint32_t n_channels,
+                        uint32_t *channels, float *values) {
+    const uint32x4_t channel_mask = vdupq_n_u32(0xffff);
+    const uint32x4_t size_mask = vdupq_n_u32(0xf);
+    const uint32x4_t signed_flag = vdupq_n_u32(0x10);
+    const uint32x4_t float_flag = vdupq_n_u32(0x20);
+    const uint32x4_t one = vdupq_n_u32(1);
+
+    size_t i = 0;
+    for(; i + 4 <= n_words; i += 4){
+        // the structured load splits the little endian words in their low and high halves
+        auto halves = vld2q_u32(reinterpret_cast<const uint32_t *>(words + i));
+        auto raw = halves.val[0];
+        auto channel = vandq_u32(halves.val[1], channel_mask);
+        auto metadata = vshrq_n_u32(halves.val[1], 16);
+
+        auto size = vaddq_u32(vandq_u32(metadata, size_mask), vdupq_n_u32(8));
+        auto pow2 = vshlq_u32(one, vreinterpretq_s32_u32(size));
+        auto sample = vandq_u32(raw, vsubq_u32(pow2, one));
+        auto sign_bit = vshrq_n_u32(pow2, 1);
+        auto extended = vsubq_u32(veorq_u32(sample, sign_bit), sign_bit);
+        sample = vbslq_u32(vtstq_u32(metadata, signed_flag), extended, sample);
+        auto converted = vcvtq_f32_s32(vreinterpretq_s32_u32(sample));
+        auto is_float = vtstq_u32(metadata, float_flag);
+
+        vst1q_u32(channels + i, channel);
+#if defined(__aarch64__)
+        auto scaling = vdupq_n_f32(scaling_factors[n_channels]);
+        for(uint32_t c = 0; c<n_channels; c++){
+            scaling = vbslq_f32(vceqq_u32(channel, vdupq_n_u32(c)), vdupq_n_f32(scaling_factors[c]), scaling);
+        }
+        auto value = vmulq_f32(scaling, converted);
+        vst1q_f32(values + i, vbslq_f32(is_float, vreinterpretq_f32_u32(raw), value));
+#else
+        // ARMv7 NEON flushes denormals to zero, so the multiplication is done by the VFP to match the scalar path
+        float converted_lanes[4];
+        uint32_t raw_lanes[4], float_lanes[4];
+        vst1q_f32(converted_lanes, converted);
+        vst1q_u32(raw_lanes, raw);
+        vst1q_u32(float_lanes, is_float);
+        for(int l = 0; l<4; l++){
+            float value = scaling_factors[std::min(channels[i+l], n_channels)]*converted_lanes[l];
+            if(float_lanes[l]) std::memcpy(&value, &raw_lanes[l], sizeof(float));
+            values[i+l] = value;
+        }
+#endif
+    }
+    decode_scalar(words + i, n_words - i, scaling_factors, n_channels, channels + i, values + i);
+}
+
+#endif
+
+/// Create a decoder using the fastest kernel supported by the CPU
+frame_decoder::frame_decoder() : frame_decoder(best_kernel()) {}
+
+/// Create a decoder using a specific kernel
+/// \param k Kernel to use, it must be supported by the CPU
+frame_decoder::frame_decoder(decode_kernel k) : kernel(k) {
+    switch (k) {
+#ifdef FRAME_DECODER_X86
+        case decode_kernel::sse2:
+            kernel_fn = decode_sse2;
+            break;
+        case decode_kernel::avx2:
+            kernel_fn = decode_avx2;
+            break;
+#endif
+#ifdef FRAME_DECODER_NEON
+        case decode_kernel::neon:
+            kernel_fn = decode_neon;
+            break;
+#endif
+        default:
+            kernel = decode_kernel::scalar;
+            kernel_fn = decode_scalar;
+            break;
+    }
+}
+
+// The channel count of the common scope geometries is baked in at compile time, so that the write positions of all
+// the channels can be kept in registers instead of being reloaded from memory at every sample. Once a channel is full
+// its write position stays on the junk slot, so the store needs no branch.
+template<uint32_t N>
+static scatter_result scatter_samples(const uint32_t *channels, const float *values, size_t n_words, uint32_t n_channels,
+                                      size_t capacity, float *const *outputs, size_t *counts) {
+    scatter_result r{0, 0};
+    if constexpr (N == 0) {
+        for(size_t i = 0; i<n_words; i++){
+            auto channel = channels[i];
+            if(channel < n_channels) {
+                auto &n = counts[channel];
+                outputs[channel][n] = values[i];
+                bool room = n < capacity;
+                n += room;
+                r.overflow += !room;
+            } else {
+                r.junk += channel == n_channels;
+            }
+        }
+    } else {
+        std::array<float *, N> out;
+        std::array<size_t, N> cnt;
+        std::copy_n(outputs, N, out.begin());
+        std::copy_n(counts, N, cnt.begin());
+        for(size_t i = 0; i<n_words; i++){
+            auto channel = channels[i];
+            if(channel < N) {
+                auto &n = cnt[channel];
+                out[channel][n] = values[i];
+                bool room = n < capacity;
+                n += room;
+                r.overflow += !room;
+            } else {
+                r.junk += channel == N;
+            }
+        }
+        std::copy_n(cnt.begin(), N, counts);
+    }
+    return r;
+}
+
+scatter_fn frame_decoder::select_scatter(uint32_t n_channels) {
+    switch (n_channels) {
+        case 4: return scatter_samples<4>;
+        case 6: return scatter_samples<6>;
+        case 8: return scatter_samples<8>;
+        case 16: return scatter_samples<16>;
+        default: return scatter_samples<0>;
+    }
+}
+
+decode_kernel frame_decoder::best_kernel() {
+    if(is_supported(decode_kernel::avx2)) return decode_kernel::avx2;
+    if(is_supported(decode_kernel::sse2)) return decode_kernel::sse2;
+    if(is_supported(decode_kernel::neon)) return decode_kernel::neon;
+    return decode_kernel::scalar;
+}
+
+bool frame_decoder::is_supported(decode_kernel k) {
+    switch (k) {
+#ifdef FRAME_DECODER_X86
+        case decode_kernel::sse2:
+            return __builtin_cpu_supports("sse2");
+        case decode_kernel::avx2:
+            return __builtin_cpu_supports("avx2");
+#endif
+#ifdef FRAME_DECODER_NEON
+        case decode_kernel::neon:
+            return true;
+#endif
+        case decode_kernel::scalar:
+            return true;
+        default:
+            return false;
+    }
+}
+
+std::string frame_decoder::kernel_name(decode_kernel k) {
+    switch (k) {
+        case decode_kernel::sse2: return "sse2";
+        case decode_kernel::avx2: return "avx2";
+        case decode_kernel::neon: return "neon";
+        default: return "scalar";
+    }
+}
+
+/// Decode the raw words of a frame into its per channel outputs, the previous contents of the outputs are discarded.
+/// Samples past the capacity of their channel are dropped. No allocation takes place once the decoder has seen a frame
+/// of the same size.
+/// \param frame Frame to decode in place
+/// \param scaling_factors Scaling factor of each channel, missing ones default to 1
+void frame_decoder::decode(scope_frame &frame, const std::vector<float> &scaling_factors) {
+    auto n_channels = frame.get_n_channels();
+    auto words = frame.raw_words();
+    auto n_words = words.size();
+
+    sf_table.assign(n_channels + 1, 1.0f);
+    std::copy_n(scaling_factors.begin(), std::min<size_t>(scaling_factors.size(), n_channels), sf_table.begin());
+    sf_table[n_channels] = 0.0f;
+
+    if(channels.size() < n_words){
+        channels.resize(n_words);
+        values.resize(n_words);
+    }
+    counts.assign(n_channels, 0);
+    outputs.resize(n_channels);
+    for(uint32_t c = 0; c<n_channels; c++) outputs[c] = frame.channel_buffer(c);
+    if(scatter == nullptr || scatter_channels != n_channels){
+        scatter = select_scatter(n_channels);
+        scatter_channels = n_channels;
+    }
+
+    kernel_fn(words.data(), n_words, sf_table.data(), n_channels, channels.data(), values.data());
+
+    // words with a channel equal to the channel count are reported as junk, higher channels are ignored
+    auto capacity = frame.get_channel_capacity();
+    auto [junk, overflow] = scatter(channels.data(), values.data(), n_words, n_channels, capacity, outputs.data(), counts.data());
+    if(overflow > 0){
+        overflow_samples += overflow;
+        spdlog::warn("FRAME OVERFLOW: {} samples past the capacity of {} samples per channel were dropped", overflow, capacity);
+    }
+    if(junk > 0){
+        junk_samples += junk;
+        for(size_t i = 0; i<n_words; i++){
+            if(channels[i] == n_channels)
+                spdlog::error("JUNK DATA DETECTED: sample number {} presents an out of range base {} ( raw data: {})", i, channels[i], words[i]);
+        }
+    }
+    for(uint32_t c = 0; c<n_channels; c++) frame.set_channel_size(c, counts[c]);
+}
@@ -0,0 +1,269 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "hw_interface/frame_recorder.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <spdlog/spdlog.h>
+
+frame_recorder::frame_recorder(std::filesystem::path root) : root(std::move(root)) {}
+
+frame_recorder::~frame_recorder() {
+    stop();
+}
+
+/// Recording names become directory names, so only a conservative set of characters is accepted
+bool frame_recorder::is_valid_name(const std::string &name) {
+    if(name.empty() || name == "." || name == "..") return false;
+    return std::ranges::all_of(name, [](char c){
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '-' || c == '.';
+    });
+}
+
+/// Start a new recording
+/// \param name Name of the recording, a directory with this name is created under the recordings root
+/// \param segment_size Size of each segment file in bytes, rounded up to hold at least one frame
+/// \param frame_words Maximum number of words in a frame
+/// \return false if a recording is already running, the name is invalid or already used, or the first segment could not be created
+/// \throw std::bad_alloc if the frame queue can not be allocated, in which case nothing is created
+bool frame_recorder::start(const std::string &name, uint64_t segment_size, size_t frame_words) {
+    std::lock_guard l(producer_mtx);
+    if(running) return false;
+    if(!is_valid_name(name)) return false;
+
+    // the queue is set up before anything is created on disk, so that running out of memory leaves no trace behind
+    auto frame_bytes = std::max<size_t>(frame_words*sizeof(uint64_t), 1);
+    auto depth = std::clamp(queue_budget/frame_bytes, min_queue_depth, max_queue_depth);
+    if(queue.size() != depth || queue[0].words.size() != frame_words){
+        queue.clear();
+        queue.assign(depth, queued_frame{{}, std::vector<uint64_t>(frame_words)});
+    }
+
+    std::error_code ec;
+    recording_dir = root / name;
+    if(std::filesystem::exists(recording_dir, ec)) {
+        spdlog::error("A recording named {0} already exists", name);
+        return false;
+    }
+    if(!std::filesystem::create_directories(recording_dir, ec)) {
+        spdlog::error("Unable to create the recording directory {0}: {1}", recording_dir.string(), ec.message());
+        return false;
+    }
+
+    auto record_size = sizeof(recorded_frame_header) + frame_words*sizeof(uint64_t);
+    this->segment_size = std::max<uint64_t>(segment_size, record_size);
+    segment_index = 0;
+    if(!open_segment()) return false;
+
+    head = 0;
+    tail = 0;
+    recorded = 0;
+    dropped = 0;
+    current_name = name;
+    running = true;
+    writer = std::thread(&frame_recorder::writer_loop, this);
+    spdlog::info("Started recording {0} in {1}", name, recording_dir.string());
+    return true;
+}
+
+/// Stop the current recording, the frames already queued are written out before returning
+void frame_recorder::stop() {
+    std::lock_guard l(producer_mtx);
+    if(!running) return;
+    running = false;
+    doorbell.fetch_add(1, std::memory_order_release);
+    doorbell.notify_one();
+    writer.join();
+    close_segment();
+    spdlog::info("Stopped recording {0}: {1} frames recorded, {2} dropped", current_name, recorded.load(), dropped.load());
+    current_name.clear();
+}
+
+/// Queue a frame for recording. Called from the acquisition path, it never blocks: the frame is dropped if the writer
+/// is behind or the recording is being started or stopped
+/// \param frame Frame whose raw words are recorded
+void frame_recorder::record(const scope_frame &frame) {
+    std::unique_lock l(producer_mtx, std::try_to_lock);
+    if(!l.owns_lock() || !running) return;
+
+    auto h = head.load(std::memory_order_relaxed);
+    if(h - tail.load(std::memory_order_acquire) >= queue.size()){
+        dropped++;
+        return;
+    }
+    auto &slot = queue[h % queue.size()];
+    auto words = frame.raw_words();
+    auto n_words = std::min(words.size(), slot.words.size());
+    std::copy_n(words.begin(), n_words, slot.words.begin());
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    slot.header = {frame_magic, static_cast<uint32_t>(n_words), frame.get_sequence(),
+                   static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count())};
+    head.store(h + 1, std::memory_order_release);
+    doorbell.fetch_add(1, std::memory_order_release);
+    doorbell.notify_one();
+}
+
+void frame_recorder::writer_loop() {
+    while(true){
+        auto bell = doorbell.load(std::memory_order_acquire);
+        auto t = tail.load(std::memory_order_relaxed);
+        auto h = head.load(std::memory_order_acquire);
+        if(t == h){
+            if(!running.load()) break;
+            doorbell.wait(bell, std::memory_order_acquire);
+            continue;
+        }
+        // drain everything queued so far, then kick off the writeback of the whole batch at once
+        for(; t != h; t++){
+            append(queue[t % queue.size()]);
+            tail.store(t + 1, std::memory_order_release);
+        }
+        if(segment_map != nullptr && segment_used > segment_synced){
+            auto page_start = segment_synced & ~static_cast<uint64_t>(getpagesize() - 1);
+            msync(segment_map + page_start, segment_used - page_start, MS_ASYNC);
+            segment_synced = segment_used;
+        }
+    }
+}
+
+void frame_recorder::append(const queued_frame &f) {
+    auto words_size = f.header.n_words*sizeof(uint64_t);
+    auto record_size = sizeof(recorded_frame_header) + words_size;
+    if(segment_used + record_size > segment_size){
+        close_segment();
+        segment_index++;
+        if(!open_segment()) {
+            dropped++;
+            return;
+        }
+    }
+    if(segment_map == nullptr) {
+        dropped++;
+        return;
+    }
+    // the words go in first, so that a reader scanning an active segment never sees a header without its data
+    std::memcpy(segment_map + segment_used + sizeof(recorded_frame_header), f.words.data(), words_size);
+    std::memcpy(segment_map + segment_used, &f.header, sizeof(recorded_frame_header));
+    segment_used += record_size;
+    recorded++;
+}
+
+bool frame_recorder::open_segment() {
+    auto path = recording_dir / fmt::format("segment_{:05}.bin", segment_index);
+    segment_fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(segment_fd < 0){
+        spdlog::error("Unable to create recording segment {0}: {1}", path.string(), std::strerror(errno));
+        return false;
+    }
+    if(posix_fallocate(segment_fd, 0, static_cast<off_t>(segment_size)) != 0 && ftruncate(segment_fd, static_cast<off_t>(segment_size)) != 0){
+        spdlog::error("Unable to allocate recording segment {0}: {1}", path.string(), std::strerror(errno));
+        close(segment_fd);
+        segment_fd = -1;
+        return false;
+    }
+    auto map = mmap(nullptr, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, segment_fd, 0);
+    if(map == MAP_FAILED){
+        spdlog::error("Unable to map recording segment {0}: {1}", path.string(), std::strerror(errno));
+        close(segment_fd);
+        segment_fd = -1;
+        return false;
+    }
+    segment_map = static_cast<uint8_t *>(map);
+    madvise(segment_map, segment_size, MADV_SEQUENTIAL);
+    segment_used = 0;
+    segment_synced = 0;
+    return true;
+}
+
+void frame_recorder::close_segment() {
+    if(segment_map != nullptr){
+        munmap(segment_map, segment_size);
+        segment_map = nullptr;
+    }
+    if(segment_fd >= 0){
+        if(ftruncate(segment_fd, static_cast<off_t>(segment_used)) != 0)
+            spdlog::error("Unable to truncate recording segment: {0}", std::strerror(errno));
+        close(segment_fd);
+        segment_fd = -1;
+    }
+}
+
+std::vector<std::filesystem::path> frame_recorder::segments_of(const std::filesystem::path &dir) {
+    std::vector<std::filesystem::path> segments;
+    std::error_code ec;
+    for(auto &e:std::filesystem::directory_iterator(dir, ec)){
+        if(e.is_regular_file() && e.path().filename().string().starts_with("segment_")) segments.push_back(e.path());
+    }
+    std::ranges::sort(segments);
+    return segments;
+}
+
+/// \return The recordings found under the recordings root
+std::vector<recording_info> frame_recorder::list() const {
+    std::vector<recording_info> ret;
+    std::error_code ec;
+    for(auto &e:std::filesystem::directory_iterator(root, ec)){
+        if(!e.is_directory()) continue;
+        recording_info info;
+        info.name = e.path().filename().string();
+        for(auto &s:segments_of(e.path())){
+            info.n_segments++;
+            std::ifstream fs(s, std::ios::binary);
+            recorded_frame_header h{};
+            while(fs.read(reinterpret_cast<char *>(&h), sizeof(h)) && h.magic == frame_magic){
+                if(info.n_frames == 0) info.first_sequence = h.sequence;
+                info.last_sequence = h.sequence;
+                info.n_frames++;
+                info.size += sizeof(h) + h.n_words*sizeof(uint64_t);
+                fs.seekg(h.n_words*sizeof(uint64_t), std::ios::cur);
+            }
+        }
+        ret.push_back(info);
+    }
+    std::ranges::sort(ret, {}, &recording_info::name);
+    return ret;
+}
+
+/// Read back a range of frames from a recording
+/// \param name Name of the recording
+/// \param first_sequence Sequence number of the first frame to return, earlier frames are skipped
+/// \param count Maximum number of frames to return
+/// \return The frames found, in recording order
+std::vector<recorded_frame> frame_recorder::fetch(const std::string &name, uint64_t first_sequence, uint64_t count) const {
+    std::vector<recorded_frame> ret;
+    if(!is_valid_name(name)) return ret;
+    for(auto &s:segments_of(root / name)){
+        std::ifstream fs(s, std::ios::binary);
+        recorded_frame_header h{};
+        while(ret.size() < count && fs.read(reinterpret_cast<char *>(&h), sizeof(h)) && h.magic == frame_magic){
+            if(h.sequence < first_sequence){
+                fs.seekg(h.n_words*sizeof(uint64_t), std::ios::cur);
+                continue;
+            }
+            recorded_frame f{h.sequence, h.timestamp_ns, std::vector<uint64_t>(h.n_words)};
+            if(!fs.read(reinterpret_cast<char *>(f.words.data()), h.n_words*sizeof(uint64_t))) break;
+            ret.push_back(std::move(f));
+        }
+        if(ret.size() >= count) break;
+    }
+    return ret;
+}
@@ -0,0 +1,136 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "hw_interface/register_sampler.hpp"
+
+void sample_ring::push(const register_sample &s) {
+    samples[head] = s;
+    head = (head + 1) % samples.size();
+    if(count < samples.size()) count++;
+}
+
+/// Copy all the samples more recent than a given timestamp, oldest first
+/// \param timestamp Timestamp of the last sample already known to the caller
+/// \param out Vector where the samples are appended
+void sample_ring::copy_since(uint64_t timestamp, std::vector<register_sample> &out) const {
+    auto first = (head + samples.size() - count) % samples.size();
+    for(size_t i = 0; i<count; i++){
+        auto &s = samples[(first + i) % samples.size()];
+        if(s.timestamp > timestamp) out.push_back(s);
+    }
+}
+
+register_sampler::~register_sampler() {
+    stop();
+}
+
+/// Start sampling a set of registers in the background, any sampling already in progress is stopped and its data
+/// discarded
+/// \param regs Addresses of the registers to sample
+/// \param frequency Sampling frequency in Hz
+/// \param depth Number of samples retained for each register
+void register_sampler::start(const std::vector<uint64_t> &regs, uint32_t frequency, size_t depth) {
+    stop();
+    spdlog::info("REGISTER SAMPLER: sampling {0} registers at {1} Hz", regs.size(), frequency);
+    addresses = regs;
+    period = std::chrono::nanoseconds(1'000'000'000/frequency);
+    overruns = 0;
+    {
+        std::lock_guard<std::mutex> lock(series_mutex);
+        series = std::vector<sample_ring>(addresses.size(), sample_ring(depth));
+    }
+    running = true;
+    sampling_thread = std::thread(&register_sampler::sampling_loop, this);
+}
+
+void register_sampler::stop() {
+    running = false;
+    if(!sampling_thread.joinable()) return;
+    sampling_thread.join();
+    spdlog::info("REGISTER SAMPLER: stopped ({0} overruns)", overruns.load());
+}
+
+/// Hold the sampler between two passes, for as long as the returned lock is held no register is read. The periods
+/// that elapse in the meantime are accounted as overruns
+/// \return Lock keeping the sampler paused
+std::unique_lock<std::mutex> register_sampler::pause() {
+    return std::unique_lock(pass_mutex);
+}
+
+/// Get the samples acquired after a given time, clients following the series pass the timestamp of the last sample
+/// they received to only get the new ones
+/// \param since Monotonic clock timestamp in ns, 0 to get the whole content of the buffers
+/// \return Object with the timestamps and values of each register
+nlohmann::json register_sampler::fetch(uint64_t since) {
+    nlohmann::json result;
+    result["period"] = period.count();
+    result["overruns"] = overruns.load();
+    result["series"] = nlohmann::json::array();
+
+    std::vector<register_sample> samples;
+    std::lock_guard<std::mutex> lock(series_mutex);
+    for(size_t i = 0; i<series.size(); i++){
+        samples.clear();
+        series[i].copy_since(since, samples);
+        std::vector<uint64_t> timestamps;
+        std::vector<uint32_t> values;
+        timestamps.reserve(samples.size());
+        values.reserve(samples.size());
+        for(auto &s:samples){
+            timestamps.push_back(s.timestamp);
+            values.push_back(s.value);
+        }
+        nlohmann::json reg;
+        reg["address"] = addresses[i];
+        reg["timestamps"] = timestamps;
+        reg["values"] = values;
+        result["series"].push_back(reg);
+    }
+    return result;
+}
+
+/// Body of the sampling thread, each pass reads all the registers under a single hold of the bus lock, which is then
+/// released until the next period so that commands are never starved. A failed bus access stops the sampler, as
+/// there is no client waiting on this thread to report it to
+void register_sampler::sampling_loop() {
+    std::vector<uint32_t> values(addresses.size());
+    auto next_sample = std::chrono::steady_clock::now();
+
+    while(running){
+        try {
+            std::lock_guard<std::mutex> pass(pass_mutex);
+            auto now = std::chrono::steady_clock::now();
+            if(hw.sample_registers(addresses, values)){
+                auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+                std::lock_guard<std::mutex> lock(series_mutex);
+                for(size_t i = 0; i<addresses.size(); i++){
+                    series[i].push({static_cast<uint64_t>(timestamp), values[i]});
+                }
+            }
+        } catch (std::exception &e) {
+            spdlog::error("REGISTER SAMPLER: stopping after a failed register read: {0}", e.what());
+            running = false;
+            break;
+        }
+
+        next_sample += period;
+        auto now = std::chrono::steady_clock::now();
+        if(next_sample < now){
+            auto missed = (now - next_sample)/period + 1;
+            overruns += missed;
+            next_sample += missed*period;
+        }
+        std::this_thread::sleep_until(next_sample);
+    }
+}
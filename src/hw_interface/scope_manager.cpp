@@ -15,128 +15,353 @@
 
 #include "hw_interface/scope_manager.hpp"
 
+#include <algorithm>
 #include <utility>
 
+#include <spdlog/fmt/ranges.h>
+
 /// Initializes the scope_handler infrastructure, opening the UIO driver file and writing to it to clear any outstanding
 /// interrupts
 /// \param driver_file Path of the driver file
 /// \param buffer_size Size of the capture buffer
-scope_manager::scope_manager() : data_gen(scope_accessor::buffer_size){
+scope_manager::scope_manager() : data_gen(scope_accessor::default_n_channels, scope_accessor::default_buffer_size),
+                                 frames(scope_accessor::default_n_channels, scope_accessor::default_n_channels*scope_accessor::default_buffer_size),
+                                 recorder(runtime_config.recordings_dir){
     spdlog::info("Scope Handler initialization started");
+    spdlog::info("Scope frame decoding kernel: {0}", frame_decoder::kernel_name(decoder.get_kernel()));
 
     first_load = true;
 
-    internal_buffer_size = scope_accessor::n_channels*scope_accessor::buffer_size;
-    data_holding_buffer.reserve(scope_accessor::n_channels*internal_buffer_size);
-    scaling_factors = {1,1,1,1,1,1};
+    scaling_factors.assign(scope_accessor::default_n_channels, 1);
+    decoding_sf = scaling_factors;
     scope_base_address = 0;
-    channel_status = {
-            {0,true},
-            {1,true},
-            {2,true},
-            {3,true},
-            {4,true},
-            {5,true},
-
-    };
+    for(uint32_t i = 0; i<scope_accessor::default_n_channels; i++) channel_status[i] = true;
 
 
     spdlog::info("Scope handler initialization done");
 }
 
-responses::response_code scope_manager::read_data(std::vector<nlohmann::json> &data_vector) {
+scope_manager::~scope_manager() {
+    stop_acquisition();
+    recorder.stop();
+}
 
-    std::vector<std::vector<float>> data;
-    std::array<uint64_t, configuration::n_channels*configuration::buffer_size> raw_data{};
-    spdlog::trace("READ_DATA: STARTING");
-    try{
-        raw_data = scope_if->get_scope_data();
-    } catch (std::runtime_error &err) {
-        return responses::ok;
+/// Make the latest frame available through get_frame(). With the acquisition thread running this only picks up the
+/// last published frame, otherwise the frame is read from the scope and decoded in place
+/// \return false if no new data was available
+bool scope_manager::acquire_frame() {
+    if(acquisition_running()) return frames.update();
+    bool recording = recorder.is_recording();
+    if(!fill_frame(frames.back(), recording)) return false;
+    frames.back().set_sequence(++frame_sequence);
+    if(recording) recorder.record(frames.back());
+    run_trigger(frames.back());
+    frames.publish();
+    return frames.update();
+}
+
+/// Read the latest frame from the scope and decode it, no allocation takes place in steady state
+/// \param target Frame to fill
+/// \param keep_raw true if the raw words must stay valid after decoding, i.e. when the frame is going to be recorded
+/// \return false if no new data was available
+bool scope_manager::fill_frame(scope_frame &target, bool keep_raw) {
+    HOT_LOG_TRACE("READ_DATA: STARTING");
+    if(sf_generation.load(std::memory_order_acquire) != decoding_sf_generation){
+        std::lock_guard l(sf_mtx);
+        decoding_sf = scaling_factors;
+        decoding_sf_generation = sf_generation.load(std::memory_order_relaxed);
     }
+    if(scope_if->is_mapped()) return fill_mapped_frame(target, keep_raw);
+    auto n_words = scope_if->read_scope_data(target.raw_buffer());
+    if(n_words == 0) return false;
+    target.set_valid_words(n_words);
+    decoder.decode(target, decoding_sf);
+    HOT_LOG_TRACE("READ_DATA: DECODED {0} WORDS", n_words);
+    return true;
+}
 
-    data = shunt_data(raw_data);
-    spdlog::trace("READ_DATA: SHUNTING DONE");
+/// Decode the latest frame straight out of the mapped DMA buffer. The frame is claimed before decoding, if a new
+/// transfer completes in the meantime the decoded data might be torn and the decoding is retried on the new frame
+/// \param target Frame to fill
+/// \param keep_raw true to copy the words out of the DMA buffer and decode the copy, so that the raw words of the frame
+/// still match the decoded samples after the next transfer
+/// \return false if no new data was available
+bool scope_manager::fill_mapped_frame(scope_frame &target, bool keep_raw) {
+    constexpr int max_attempts = 3;
+    for(int i = 0; i<max_attempts; i++){
+        if(!scope_if->claim_mapped_frame()) return i>0;
+        auto mapped = scope_if->get_mapped_frame();
+        if(keep_raw){
+            auto raw = target.raw_buffer();
+            auto n_words = std::min(mapped.size(), raw.size());
+            std::copy_n(mapped.begin(), n_words, raw.begin());
+            target.set_valid_words(n_words);
+        } else {
+            target.set_source(mapped);
+        }
+        decoder.decode(target, decoding_sf);
+        if(!scope_if->new_data_available()) {
+            HOT_LOG_TRACE("READ_DATA: DECODED MAPPED FRAME");
+            return true;
+        }
+        HOT_LOG_DEBUG("READ_DATA: DMA BUFFER OVERWRITTEN WHILE DECODING, RETRYING");
+    }
+    spdlog::warn("The scope DMA buffer was overwritten {0} times while decoding, the frame might be torn", max_attempts);
+    return true;
+}
 
-    for(int i = 0; i<scope_accessor::n_channels; i++){
-        nlohmann::json ch_obj;
-        if(channel_status[i]){
-            ch_obj["channel"] = i;
-            ch_obj["data"] = data[i];
-            data_vector.push_back(ch_obj);
+/// Start a thread that waits on the scope device and decodes every frame as soon as it is signalled, publishing it
+/// for read_data. Client requests then never touch the device
+void scope_manager::start_acquisition() {
+    if(acquisition_running()) return;
+    spdlog::info("Starting the scope acquisition thread");
+    acquisition_stop = false;
+    acquisition_thread = std::thread(&scope_manager::acquisition_loop, this);
+}
+
+void scope_manager::stop_acquisition() {
+    if(!acquisition_running()) return;
+    acquisition_stop = true;
+    acquisition_thread.join();
+    spdlog::info("Scope acquisition thread stopped");
+}
+
+void scope_manager::acquisition_loop() {
+    while(!acquisition_stop.load(std::memory_order_relaxed)){
+        if(!scope_if->wait_for_data(std::chrono::milliseconds(100))) continue;
+        auto &target = frames.back();
+        bool recording = recorder.is_recording();
+        if(!fill_frame(target, recording)) continue;
+        target.set_sequence(++frame_sequence);
+        if(recording) recorder.record(target);
+        run_trigger(target);
+        frames.publish();
+        {
+            std::lock_guard l(publish_mtx);
         }
+        frame_published.notify_all();
     }
-    return responses::ok;
 }
 
+/// Wait for the acquisition thread to publish a frame the client has not seen yet
+/// \param timeout Maximum time to wait, clamped to scope_accessor::max_wait_timeout
+/// \return true if the front frame now holds new data
+bool scope_manager::wait_published_frame(std::chrono::milliseconds timeout) {
+    timeout = std::clamp(timeout, std::chrono::milliseconds::zero(), scope_accessor::max_wait_timeout);
+    std::unique_lock l(publish_mtx);
+    return frame_published.wait_for(l, timeout, [this]{return frames.update();});
+}
 
+/// \return The samples as a binary blob of little endian 32 bit floats, or as an array of numbers
+static nlohmann::json pack_samples(std::span<const float> samples, bool binary) {
+    if(!binary) return samples;
+    auto bytes = std::as_bytes(samples);
+    auto first = reinterpret_cast<const uint8_t *>(bytes.data());
+    return nlohmann::json::binary(std::vector<uint8_t>(first, first + bytes.size()));
+}
 
-std::vector<std::vector<float>> scope_manager::shunt_data(
-    const std::array<uint64_t, configuration::n_channels*configuration::buffer_size>  &buffer_in
-) {
-    std::vector<std::vector<float>> ret_data;
-    for(int i = 0; i<scope_accessor::n_channels; i++){
-        ret_data.emplace_back();
+/// Acquire a frame and pack the data of the enabled channels
+/// \param data_vector Vector where an object for each enabled channel is placed
+/// \param options Packing of the samples, decimation and whether to block until the scope signals a new frame. When
+/// decimating, the position of each returned sample in the frame is reported in the "index" field of the channel.
+/// With a spectrum requested, each channel carries its "magnitude" and/or "phase" instead of the samples
+/// \return Success, or no_new_data if waiting for a new frame timed out
+responses::response_code scope_manager::read_data(std::vector<nlohmann::json> &data_vector, const read_data_options &options) {
+    if(acquisition_running()){
+        bool fresh = frames.update();
+        if(options.wait_new_data && !fresh && !wait_published_frame(options.timeout)) return responses::no_new_data;
+        if(frames.front().get_sequence() == 0) return responses::ok;
+    } else if(options.wait_new_data){
+        if(!scope_if->wait_for_data(options.timeout) || !acquire_frame()) return responses::no_new_data;
+    } else if(!acquire_frame()) {
+        return responses::ok;
     }
-    spdlog::trace("SETUP {0} RESULTS BUFFERS", scope_accessor::n_channels);
-    for(int i = 0; i<internal_buffer_size; i++){
 
-        spdlog::trace("ACCESSING SAMPLE NUMBER {0}", i);
-        auto raw_sample = buffer_in[i];
-        int channel_base = GET_CHANNEL(raw_sample);
-        auto sample = GET_DATA(raw_sample);
-        auto metadata = channel_metadata(GET_METADATA(raw_sample));
-        float data_sample;
-        spdlog::trace("PROCESSING SAMPLE NUMBER {0}", i);
-        if(channel_base<0|| channel_base>scope_accessor::n_channels){
+    auto &frame = frames.front();
+    for(uint32_t i = 0; i<frame.get_n_channels(); i++){
+        if(auto st = channel_status.find(i); st == channel_status.end() || !st->second) continue;
+        auto samples = frame.channel(i);
+        nlohmann::json ch_obj;
+        ch_obj["channel"] = i;
+        if(options.spectrum){
+            analyzer.compute(i, frame.get_sequence(), samples, *options.spectrum);
+            if(options.spectrum->magnitude) ch_obj["magnitude"] = pack_samples(analyzer.get_magnitude(), options.binary);
+            if(options.spectrum->phase) ch_obj["phase"] = pack_samples(analyzer.get_phase(), options.binary);
+            data_vector.push_back(std::move(ch_obj));
             continue;
         }
-
-        spdlog::trace("channel base = {0}", channel_base);
-        auto scaling_factor = scaling_factors[channel_base];
-        data_sample = scale_data(sample, metadata.get_size(), scaling_factor, metadata.is_signed(), metadata.is_float());
-        spdlog::trace("SCALING DONE");
-        if(channel_base < scope_accessor::n_channels) {
-            ret_data[channel_base].push_back(data_sample);
-        } else {
-            spdlog::error("JUNK DATA DETECTED: sample number {} presents an out of range base {} ( raw data: {})",i, channel_base, raw_sample);
+        if(options.decimation != decimation_mode::none){
+            decimator.decimate(options.decimation, samples, options.max_points);
+            samples = decimator.get_values();
+            auto indices = decimator.get_indices();
+            if(options.binary){
+                auto bytes = std::as_bytes(indices);
+                auto first = reinterpret_cast<const uint8_t *>(bytes.data());
+                ch_obj["index"] = nlohmann::json::binary(std::vector<uint8_t>(first, first + bytes.size()));
+            } else {
+                ch_obj["index"] = indices;
+            }
         }
-        spdlog::trace("PUSHED SAMPLE TO OUTPUT ARRAY");
+        ch_obj["data"] = pack_samples(samples, options.binary);
+        data_vector.push_back(std::move(ch_obj));
     }
-    return ret_data;
+    return responses::ok;
 }
 
-float scope_manager::scale_data(uint32_t raw_sample, unsigned int size, float scaling_factor, bool is_signed, bool is_float) {
+/// Run the software trigger on a freshly acquired frame, picking up any configuration change first. New
+/// configurations arrive as engines already set up by the caller of set_software_trigger, so no trigger buffer is
+/// allocated here
+/// \param frame Frame to feed to the trigger engine
+void scope_manager::run_trigger(const scope_frame &frame) {
+    if(trigger_generation.load(std::memory_order_acquire) != applied_trigger_generation){
+        std::lock_guard l(trigger_mtx);
+        if(staged_trigger) trigger_engine = std::move(*staged_trigger);
+        else trigger_engine.disable();
+        staged_trigger.reset();
+        applied_trigger_generation = trigger_generation.load(std::memory_order_relaxed);
+    }
+    if(!trigger_engine.is_enabled()) return;
+    try {
+        if(trigger_engine.process(frame, captures.back())) captures.publish();
+    } catch (std::bad_alloc &) {
+        spdlog::error("Out of memory while capturing a software trigger window, the trigger is disabled");
+        trigger_engine.disable();
+    }
+}
 
-    spdlog::trace("START DATA SCALING");
-    float ret;
+/// Set up a trigger engine for the current scope geometry
+/// \param cfg Trigger configuration
+/// \return The configured engine, or nullopt if its buffers could not be allocated
+std::optional<software_trigger> scope_manager::stage_trigger(const trigger_config &cfg) const {
+    std::optional<software_trigger> engine;
+    try {
+        engine.emplace();
+        engine->configure(cfg, scope_if->get_n_channels(), scope_if->get_buffer_size());
+    } catch (std::bad_alloc &) {
+        spdlog::error("Unable to allocate the software trigger buffers for {0} pre trigger and {1} post trigger samples", cfg.pre_trigger, cfg.post_trigger);
+        engine.reset();
+    }
+    return engine;
+}
 
-    int32_t sample;
-    if(!is_signed) {
-        sample = raw_sample & ((1 << size) - 1);
+/// Configure the software trigger, that runs on every acquired frame. Without the background acquisition thread
+/// only the frames acquired by read_data are seen by the trigger, and they are not contiguous
+/// \param cfg Trigger configuration, or nullopt to disable the trigger
+/// \return Success, or invalid_arg if the configuration refers to missing channels, has no conditions or its buffers
+/// can not be allocated
+responses::response_code scope_manager::set_software_trigger(const std::optional<trigger_config> &cfg) {
+    std::optional<software_trigger> engine;
+    if(cfg){
+        if(cfg->conditions.empty()) return responses::invalid_arg;
+        for(auto &c:cfg->conditions) if(c.channel >= scope_if->get_n_channels()) return responses::invalid_arg;
+        spdlog::info("SET_SOFTWARE_TRIGGER: {0} conditions, {1} pre trigger and {2} post trigger samples", cfg->conditions.size(), cfg->pre_trigger, cfg->post_trigger);
+        engine = stage_trigger(*cfg);
+        if(!engine) return responses::invalid_arg;
     } else {
-        auto masked_sample = raw_sample & ((1<<size)-1);
-        sample = sign_extend(masked_sample, size);
+        spdlog::info("SET_SOFTWARE_TRIGGER: disabled");
     }
+    std::lock_guard l(trigger_mtx);
+    requested_trigger = cfg;
+    staged_trigger = std::move(engine);
+    trigger_generation.fetch_add(1, std::memory_order_release);
+    return responses::ok;
+}
 
-    spdlog::trace("SIGN AND WIDTH HANDLING DONE");
+/// Pack the last capture of the software trigger
+/// \param capture_out Object where the capture is placed
+/// \param binary true to pack each channel as a binary blob of little endian 32 bit floats
+/// \return Success, or no_new_data if no capture was completed since the last call
+responses::response_code scope_manager::read_trigger_capture(nlohmann::json &capture_out, bool binary) {
+    if(!captures.update()) return responses::no_new_data;
+    auto &c = captures.front();
+    capture_out["sequence"] = c.sequence;
+    capture_out["trigger_position"] = c.trigger_position;
+    capture_out["pre_trigger"] = c.pre_trigger;
+    std::vector<nlohmann::json> channels;
+    for(uint32_t i = 0; i<c.channels.size(); i++){
+        nlohmann::json ch_obj;
+        ch_obj["channel"] = i;
+        if(binary){
+            auto bytes = std::as_bytes(std::span(c.channels[i]));
+            auto first = reinterpret_cast<const uint8_t *>(bytes.data());
+            ch_obj["data"] = nlohmann::json::binary(std::vector<uint8_t>(first, first + bytes.size()));
+        } else {
+            ch_obj["data"] = c.channels[i];
+        }
+        channels.push_back(std::move(ch_obj));
+    }
+    capture_out["channels"] = std::move(channels);
+    return responses::ok;
+}
 
-    spdlog::trace("Scale factor: {0}, sample value {1}", scaling_factor, sample);
-    ret = scaling_factor*(float)sample;
-    if(is_float){
-        memcpy(&ret, &raw_sample, sizeof(float));
+/// Start recording every acquired frame to disk. Without the background acquisition thread only the frames acquired
+/// by read_data are recorded
+/// \param name Name of the recording
+/// \param segment_size Size of each segment file in bytes
+/// \return Success, invalid_arg if a recording is already running or the recording could not be created, internal_error
+/// if there is not enough memory for the frame queue
+responses::response_code scope_manager::start_recording(const std::string &name, uint64_t segment_size) {
+    if(recorder.is_recording() || !frame_recorder::is_valid_name(name)) return responses::invalid_arg;
+    try {
+        if(!recorder.start(name, segment_size, scope_if->get_frame_words())) return responses::invalid_arg;
+    } catch (std::bad_alloc &) {
+        spdlog::error("Not enough memory for the frame queue of recording {0}", name);
+        return responses::internal_error;
+    }
+    return responses::ok;
+}
+
+responses::response_code scope_manager::stop_recording() {
+    recorder.stop();
+    return responses::ok;
+}
+
+nlohmann::json scope_manager::get_recordings() {
+    nlohmann::json ret = nlohmann::json::array();
+    for(auto &r:recorder.list()){
+        nlohmann::json rec;
+        rec["name"] = r.name;
+        rec["segments"] = r.n_segments;
+        rec["frames"] = r.n_frames;
+        rec["size"] = r.size;
+        rec["first_sequence"] = r.first_sequence;
+        rec["last_sequence"] = r.last_sequence;
+        rec["active"] = recorder.is_recording() && recorder.get_current_recording() == r.name;
+        ret.push_back(rec);
     }
     return ret;
 }
 
+/// Read back a range of recorded frames, each as an object with its sequence number, its timestamp in nanoseconds
+/// and its raw words as a binary blob of little endian 64 bit words
+/// \param name Name of the recording
+/// \param first Sequence number of the first frame
+/// \param count Maximum number of frames
+/// \param frames_out Vector where the frame objects are placed
+/// \return Success
+responses::response_code scope_manager::fetch_recording(const std::string &name, uint64_t first, uint64_t count, std::vector<nlohmann::json> &frames_out) {
+    if(!frame_recorder::is_valid_name(name)) return responses::invalid_arg;
+    for(auto &f:recorder.fetch(name, first, count)){
+        nlohmann::json frame_obj;
+        frame_obj["sequence"] = f.sequence;
+        frame_obj["timestamp"] = f.timestamp_ns;
+        auto first_byte = reinterpret_cast<const uint8_t *>(f.words.data());
+        frame_obj["data"] = nlohmann::json::binary(std::vector<uint8_t>(first_byte, first_byte + f.words.size()*sizeof(uint64_t)));
+        frames_out.push_back(std::move(frame_obj));
+    }
+    return responses::ok;
+}
+
 responses::response_code  scope_manager::set_scaling_factors(std::vector<float> &sf) {
-    spdlog::info("SET_SCALING_FACTORS: {0} {1} {2} {3} {4} {5}",sf[0], sf[1], sf[2], sf[3], sf[4], sf[5]);
+    spdlog::info("SET_SCALING_FACTORS: {0}", fmt::join(sf, " "));
+    std::lock_guard l(sf_mtx);
     scaling_factors = sf;
+    sf_generation.fetch_add(1, std::memory_order_release);
     return responses::ok;
 }
 
 responses::response_code scope_manager::set_channel_status(std::unordered_map<int, bool> status) {
-    spdlog::info("SET_STATUSES: {0} {1} {2} {3} {4} {5}",status[0], status[1], status[2], status[3], status[4], status[5]);
+    for(auto &[ch, enabled]:status) spdlog::info("SET_STATUS: channel {0} {1}", ch, enabled ? "enabled" : "disabled");
     channel_status = std::move(status);
     return responses::ok;
 }
@@ -144,8 +369,8 @@ responses::response_code scope_manager::set_channel_status(std::unordered_map<in
 
 std::string scope_manager::get_acquisition_status() {
     if(scope_base_address == 0) return "not present";
-    spdlog::trace("GET_ACQUISITION_STATUS");
-    auto res = hw.read_direct(scope_base_address + am.internal_base + am.scope_int.trg_rearm_status);
+    HOT_LOG_TRACE("GET_ACQUISITION_STATUS");
+    auto res = scope_registers().sub<scope_block::internal>().read<scope_internal_block::trg_rearm_status>();
     switch (res) {
         case 0:
             return "wait";
@@ -169,7 +394,7 @@ responses::response_code scope_manager::set_acquisition(const acquisition_metada
                  data.trigger_level,
                  scope_base_address
     );
-    uint64_t scope_internal_addr = scope_base_address + am.internal_base;
+    auto scope_int = scope_registers().sub<scope_block::internal>();
 
     uint32_t trg_mode = 0;
     if(data.trigger_mode == "rising_edge"){
@@ -180,8 +405,8 @@ responses::response_code scope_manager::set_acquisition(const acquisition_metada
         trg_mode = 2;
     }
 
-    hw.write_direct(scope_internal_addr + am.scope_int.trg_mode, trg_mode);
-    hw.write_direct(scope_internal_addr + am.scope_int.trg_src, data.trigger_source-1);
+    scope_int.write<scope_internal_block::trg_mode>(trg_mode);
+    scope_int.write<scope_internal_block::trg_src>(data.trigger_source-1);
 
     uint32_t trg_lvl;
     if(data.level_type =="float"){
@@ -189,7 +414,7 @@ responses::response_code scope_manager::set_acquisition(const acquisition_metada
     } else {
         trg_lvl = float_to_uint32(data.trigger_level);
     }
-    hw.write_direct(scope_internal_addr + am.scope_int.trg_lvl, trg_lvl);
+    scope_int.write<scope_internal_block::trg_lvl>(trg_lvl);
 
 
     uint32_t acq_mode = 0;
@@ -200,12 +425,13 @@ responses::response_code scope_manager::set_acquisition(const acquisition_metada
     } else if(data.mode == "free_running") {
         acq_mode = 2;
     }
-    hw.write_direct(scope_internal_addr + am.scope_int.acq_mode, acq_mode);
-    hw.write_direct(scope_internal_addr + am.scope_int.trg_point, data.trigger_point);
+    scope_int.write<scope_internal_block::acq_mode>(acq_mode);
+    scope_int.write<scope_internal_block::trg_point>(data.trigger_point);
     if(data.prescaler >2){
-        hw.write_direct(scope_base_address + am.tb_base + am.tb.ctrl, 1);
-        hw.write_direct(scope_base_address + am.tb_base + am.tb.period, data.prescaler);
-        hw.write_direct(scope_base_address + am.tb_base + am.tb.threshold, 1);
+        auto tb = scope_registers().sub<scope_block::tb>();
+        tb.write<scope_timebase_block::ctrl>(1);
+        tb.write<scope_timebase_block::period>(data.prescaler);
+        tb.write<scope_timebase_block::threshold>(1);
     }
 
 
@@ -214,8 +440,23 @@ responses::response_code scope_manager::set_acquisition(const acquisition_metada
 
 void scope_manager::set_scope_address(uint64_t addr, uint64_t buffer_offset) {
     spdlog::info("SET SCOPE ADDRESS: {0:x}", addr);
-    hw.set_scope_data(addr + buffer_offset);
     scope_base_address = addr;
+    auto scope = scope_registers();
+    scope.map();
+    hw.define_bus_region("scope", addr, scope_block::size);
+    hw.set_scope_data(addr + buffer_offset);
+
+    scope.sub<scope_block::mux>().declare_idempotent<scope_mux_block::ctrl>();
+    auto tb = scope.sub<scope_block::tb>();
+    tb.declare_idempotent<scope_timebase_block::ctrl>();
+    tb.declare_idempotent<scope_timebase_block::period>();
+    tb.declare_idempotent<scope_timebase_block::threshold>();
+    auto scope_int = scope.sub<scope_block::internal>();
+    scope_int.declare_idempotent<scope_internal_block::trg_mode>();
+    scope_int.declare_idempotent<scope_internal_block::trg_lvl>();
+    scope_int.declare_idempotent<scope_internal_block::trg_src>();
+    scope_int.declare_idempotent<scope_internal_block::trg_point>();
+    scope_int.declare_idempotent<scope_internal_block::acq_mode>();
 }
 
 void scope_manager::disable_dma(bool status) {
@@ -228,15 +469,37 @@ void scope_manager::disable_dma(bool status) {
     else
         spdlog::info("ENABLE_SCOPE_DMA");
 
-    auto write_addr = scope_base_address + am.mux_base + am.mux.ctrl;
-    if(write_addr != 0){
-        hw.write_direct(write_addr, status);
+    auto mux = scope_registers().sub<scope_block::mux>();
+    if(mux.address<scope_mux_block::ctrl>() != 0){
+        // nothing changes on the hardware when the shadow copy shows the mux already in the requested state
+        if(hw.register_holds(mux.address<scope_mux_block::ctrl>(), status)) return;
+        mux.write<scope_mux_block::ctrl>(status);
+        // the mux has no status bit acknowledging the toggle, so there is no condition for wait_for to poll on
         usleep(50'000);
     }
 }
 
 void scope_manager::set_accessors(const std::shared_ptr<bus_accessor> &ba, std::shared_ptr<scope_accessor> sa) {
+    stop_acquisition();
     hw.set_accessor(ba);
     scope_if = sa;
+
+    auto n_channels = scope_if->get_n_channels();
+    auto buffer_size = scope_if->get_buffer_size();
+    frames.reset(n_channels, scope_if->get_frame_words());
+    data_gen = emulated_data_generator(n_channels, buffer_size);
+    {
+        std::lock_guard l(sf_mtx);
+        scaling_factors.resize(n_channels, 1);
+        sf_generation.fetch_add(1, std::memory_order_release);
+    }
+    for(uint32_t i = 0; i<n_channels; i++) channel_status.try_emplace(i, true);
+    {
+        std::lock_guard l(trigger_mtx);
+        if(requested_trigger) staged_trigger = stage_trigger(*requested_trigger);
+        if(!staged_trigger) requested_trigger.reset();
+        trigger_generation.fetch_add(1, std::memory_order_release);
+    }
+    if(runtime_config.background_acquisition) start_acquisition();
 }
 
@@ -0,0 +1,283 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+    #define SOFTWARE_TRIGGER_SSE
+#endif
+
+#include <spdlog/spdlog.h>
+
+#include "hw_interface/software_trigger.hpp"
+
+/// Set bit i of the output when samples[i] > level, 64 samples per word with the first sample in the LSB
+static void threshold_bits(const float *samples, size_t n, float level, uint64_t *out) {
+    size_t i = 0;
+#if defined(SOFTWARE_TRIGGER_SSE)
+    __m128 lvl = _mm_set1_ps(level);
+    for(; i + 64 <= n; i += 64){
+        uint64_t word = 0;
+        for(int b = 0; b<64; b += 4){
+            auto mask = _mm_movemask_ps(_mm_cmpgt_ps(_mm_loadu_ps(samples + i + b), lvl));
+            word |= static_cast<uint64_t>(mask) << b;
+        }
+        out[i/64] = word;
+    }
+#endif
+    for(; i<n; i += 64){
+        uint64_t word = 0;
+        auto count = std::min<size_t>(64, n - i);
+        for(size_t b = 0; b<count; b++) word |= static_cast<uint64_t>(samples[i + b] > level) << b;
+        out[i/64] = word;
+    }
+}
+
+/// \return The word of bits delayed by one sample, carry being the state of the sample preceding the frame
+static uint64_t previous_bits(const std::vector<uint64_t> &bits, size_t w, bool carry) {
+    return bits[w] << 1 | (w == 0 ? static_cast<uint64_t>(carry) : bits[w - 1] >> 63);
+}
+
+static bool bit(const std::vector<uint64_t> &bits, size_t i) {
+    return (bits[i/64] >> (i%64)) & 1;
+}
+
+std::optional<trigger_condition_type> software_trigger::parse_type(const std::string &type) {
+    if(type == "level") return trigger_condition_type::level;
+    if(type == "edge") return trigger_condition_type::edge;
+    if(type == "window") return trigger_condition_type::window;
+    if(type == "pulse_width") return trigger_condition_type::pulse_width;
+    if(type == "runt") return trigger_condition_type::runt;
+    return std::nullopt;
+}
+
+std::optional<trigger_polarity> software_trigger::parse_polarity(const std::string &polarity) {
+    if(polarity == "positive" || polarity == "rising") return trigger_polarity::positive;
+    if(polarity == "negative" || polarity == "falling") return trigger_polarity::negative;
+    if(polarity == "either") return trigger_polarity::either;
+    return std::nullopt;
+}
+
+/// Set up the engine for a new trigger, discarding the history of the previous one
+/// \param cfg Trigger conditions and capture depth
+/// \param n_channels Number of channels of the scope
+/// \param frame_samples Expected number of samples per channel in each frame
+/// \return false if the configuration refers to missing channels or has no conditions
+bool software_trigger::configure(const trigger_config &cfg, uint32_t n_channels, size_t frame_samples) {
+    enabled = false;
+    if(cfg.conditions.empty()) return false;
+    for(auto &c:cfg.conditions) if(c.channel >= n_channels) return false;
+
+    config = cfg;
+    config.post_trigger = std::max<uint32_t>(config.post_trigger, 1);
+    this->n_channels = n_channels;
+    this->frame_samples = frame_samples;
+    oversized_frames = 0;
+    history_size = config.pre_trigger + config.post_trigger + 2*frame_samples;
+    history.assign(n_channels, std::vector<float>(history_size));
+
+    auto n_words = (frame_samples + 63)/64;
+    conditions.clear();
+    for(auto &c:config.conditions){
+        condition_state st;
+        st.cfg = c;
+        st.primary.resize(n_words);
+        st.secondary.resize(n_words);
+        st.events.resize(n_words);
+        conditions.push_back(std::move(st));
+    }
+    combined.resize(n_words);
+    stream_position = 0;
+    holdoff = config.pre_trigger;
+    pending.reset();
+    enabled = true;
+    return true;
+}
+
+void software_trigger::evaluate(condition_state &c, const float *samples, size_t n) {
+    auto n_words = (n + 63)/64;
+    auto valid = [n, n_words](size_t w) {
+        return (w == n_words - 1 && n%64) ? (uint64_t(1) << (n%64)) - 1 : ~uint64_t(0);
+    };
+    auto &cfg = c.cfg;
+    auto &P = c.primary;
+    auto &S = c.secondary;
+    auto &ev = c.events;
+    threshold_bits(samples, n, cfg.level, P.data());
+    if(cfg.type == trigger_condition_type::window || cfg.type == trigger_condition_type::runt)
+        threshold_bits(samples, n, cfg.upper, S.data());
+
+    switch (cfg.type) {
+        case trigger_condition_type::level:
+            for(size_t w = 0; w<n_words; w++) ev[w] = cfg.polarity == trigger_polarity::negative ? ~P[w] : P[w];
+            break;
+        case trigger_condition_type::edge:
+            for(size_t w = 0; w<n_words; w++){
+                auto prev = previous_bits(P, w, c.prev_primary);
+                auto rising = P[w] & ~prev;
+                auto falling = ~P[w] & prev;
+                ev[w] = cfg.polarity == trigger_polarity::positive ? rising :
+                        cfg.polarity == trigger_polarity::negative ? falling : rising | falling;
+            }
+            break;
+        case trigger_condition_type::window:
+            for(size_t w = 0; w<n_words; w++){
+                // outside the window: above the upper threshold or not above the lower one
+                auto outside = S[w] | ~P[w];
+                auto prev_outside = previous_bits(S, w, c.prev_secondary) | ~previous_bits(P, w, c.prev_primary);
+                auto exiting = outside & ~prev_outside;
+                auto entering = ~outside & prev_outside;
+                ev[w] = cfg.polarity == trigger_polarity::positive ? exiting :
+                        cfg.polarity == trigger_polarity::negative ? entering : exiting | entering;
+            }
+            break;
+        case trigger_condition_type::pulse_width:
+            for(size_t w = 0; w<n_words; w++){
+                ev[w] = 0;
+                auto transitions = (P[w] ^ previous_bits(P, w, c.prev_primary)) & valid(w);
+                while(transitions){
+                    auto b = std::countr_zero(transitions);
+                    transitions &= transitions - 1;
+                    auto position = stream_position + w*64 + b;
+                    bool now_high = (P[w] >> b) & 1;
+                    // the segment ending here is a pulse of the selected polarity
+                    bool pulse_end = cfg.polarity == trigger_polarity::either ||
+                                     (cfg.polarity == trigger_polarity::positive && !now_high) ||
+                                     (cfg.polarity == trigger_polarity::negative && now_high);
+                    if(pulse_end && c.in_pulse){
+                        auto width = position - c.pulse_start;
+                        if(width >= cfg.min_width && width <= cfg.max_width) ev[w] |= uint64_t(1) << b;
+                    }
+                    c.pulse_start = position;
+                    c.in_pulse = true;
+                }
+            }
+            break;
+        case trigger_condition_type::runt:
+            for(size_t w = 0; w<n_words; w++){
+                ev[w] = 0;
+                auto low_transitions = P[w] ^ previous_bits(P, w, c.prev_primary);
+                auto high_transitions = S[w] ^ previous_bits(S, w, c.prev_secondary);
+                auto transitions = (low_transitions | high_transitions) & valid(w);
+                while(transitions){
+                    auto b = std::countr_zero(transitions);
+                    transitions &= transitions - 1;
+                    bool low_changed = (low_transitions >> b) & 1;
+                    bool high_changed = (high_transitions >> b) & 1;
+                    bool above_low = (P[w] >> b) & 1;
+                    bool above_high = (S[w] >> b) & 1;
+                    bool fire = false;
+                    if(cfg.polarity != trigger_polarity::negative){
+                        // rising through the low threshold, and back below it without reaching the high one
+                        if(low_changed && above_low) {c.armed = true; c.reached = false;}
+                        if(high_changed && above_high) c.reached = true;
+                        if(low_changed && !above_low) {
+                            fire |= c.armed && !c.reached;
+                            c.armed = false;
+                        }
+                    }
+                    if(cfg.polarity != trigger_polarity::positive){
+                        // falling through the high threshold, and back above it without reaching the low one
+                        if(high_changed && !above_high) {c.armed_negative = true; c.reached_negative = false;}
+                        if(low_changed && !above_low) c.reached_negative = true;
+                        if(high_changed && above_high) {
+                            fire |= c.armed_negative && !c.reached_negative;
+                            c.armed_negative = false;
+                        }
+                    }
+                    if(fire) ev[w] |= uint64_t(1) << b;
+                }
+            }
+            break;
+    }
+    // clear the bits past the end of the frame
+    ev[n_words - 1] &= valid(n_words - 1);
+    c.prev_primary = bit(P, n - 1);
+    c.prev_secondary = bit(S, n - 1);
+}
+
+void software_trigger::emit(uint64_t trigger_position, trigger_capture &out) {
+    auto depth = config.pre_trigger + config.post_trigger;
+    auto first = trigger_position - config.pre_trigger;
+    out.channels.resize(n_channels);
+    for(uint32_t ch = 0; ch<n_channels; ch++){
+        out.channels[ch].resize(depth);
+        for(size_t i = 0; i<depth; i++) out.channels[ch][i] = history[ch][(first + i)%history_size];
+    }
+    out.sequence = ++trigger_count;
+    out.trigger_position = trigger_position;
+    out.pre_trigger = config.pre_trigger;
+}
+
+/// Feed a decoded frame to the engine
+/// \param frame Frame following the previous one in the acquisition stream
+/// \param out Capture to fill when a trigger window is completed, if more than one completes in the same frame only
+/// the last one is kept
+/// \return true if out holds a new capture
+bool software_trigger::process(const scope_frame &frame, trigger_capture &out) {
+    if(!enabled || frame.get_n_channels() != n_channels) return false;
+    size_t n = frame.channel(0).size();
+    for(uint32_t ch = 1; ch<n_channels; ch++) n = std::min(n, frame.channel(ch).size());
+    if(n == 0) return false;
+    if(n > frame_samples){
+        // the buffers are sized for the staged geometry and can not grow on the acquisition thread, so the frame is
+        // skipped until the trigger is staged again for the new geometry
+        if(oversized_frames++ == 0)
+            spdlog::warn("SOFTWARE TRIGGER: skipping frames of {0} samples, deeper than the configured {1}", n, frame_samples);
+        return false;
+    }
+
+    for(uint32_t ch = 0; ch<n_channels; ch++){
+        auto samples = frame.channel(ch);
+        for(size_t i = 0; i<n; i++) history[ch][(stream_position + i)%history_size] = samples[i];
+    }
+
+    auto n_words = (n + 63)/64;
+    for(auto &c:conditions) evaluate(c, frame.channel(c.cfg.channel).data(), n);
+    for(size_t w = 0; w<n_words; w++){
+        uint64_t word = conditions[0].events[w];
+        for(size_t c = 1; c<conditions.size(); c++)
+            word = config.combine_and ? word & conditions[c].events[w] : word | conditions[c].events[w];
+        combined[w] = word;
+    }
+
+    bool captured = false;
+    auto stream_end = stream_position + n;
+    if(pending && *pending + config.post_trigger <= stream_end){
+        emit(*pending, out);
+        pending.reset();
+        captured = true;
+    }
+    while(!pending && holdoff < stream_end){
+        auto start = holdoff > stream_position ? holdoff - stream_position : 0;
+        std::optional<uint64_t> found;
+        for(size_t w = start/64; w<n_words && !found; w++){
+            auto word = combined[w];
+            if(w == start/64) word &= ~uint64_t(0) << (start%64);
+            if(word) found = stream_position + w*64 + std::countr_zero(word);
+        }
+        if(!found) break;
+        holdoff = *found + config.post_trigger;
+        if(*found + config.post_trigger <= stream_end){
+            emit(*found, out);
+            captured = true;
+        } else {
+            pending = found;
+        }
+    }
+    stream_position = stream_end;
+    return captured;
+}
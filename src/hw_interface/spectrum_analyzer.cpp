@@ -0,0 +1,120 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include "hw_interface/spectrum_analyzer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <numeric>
+
+std::optional<spectrum_window> spectrum_analyzer::parse_window(const std::string &window) {
+    if(window == "rectangular") return spectrum_window::rectangular;
+    if(window == "hann") return spectrum_window::hann;
+    if(window == "hamming") return spectrum_window::hamming;
+    if(window == "blackman") return spectrum_window::blackman;
+    if(window == "flat_top") return spectrum_window::flat_top;
+    return std::nullopt;
+}
+
+real_fft_plan &spectrum_analyzer::plan_for(size_t n) {
+    auto &p = plans[n];
+    if(!p) p = std::make_unique<real_fft_plan>(n);
+    return *p;
+}
+
+const std::vector<float> &spectrum_analyzer::window_for(spectrum_window window, size_t n) {
+    auto &w = windows[{window, n}];
+    if(w.size() == n) return w;
+    // periodic windows, as the frame is analysed as one period of the spectrum
+    static const std::map<spectrum_window, std::vector<double>> coefficients = {
+        {spectrum_window::rectangular, {1.0}},
+        {spectrum_window::hann, {0.5, 0.5}},
+        {spectrum_window::hamming, {0.54, 0.46}},
+        {spectrum_window::blackman, {0.42, 0.5, 0.08}},
+        {spectrum_window::flat_top, {0.21557895, 0.41663158, 0.277263158, 0.083578947, 0.006947368}},
+    };
+    auto &a = coefficients.at(window);
+    w.resize(n);
+    for(size_t j = 0; j<n; j++){
+        double value = 0;
+        double sign = 1;
+        for(size_t k = 0; k<a.size(); k++){
+            value += sign*a[k]*std::cos(2.0*std::numbers::pi*static_cast<double>(k*j)/static_cast<double>(n));
+            sign = -sign;
+        }
+        w[j] = static_cast<float>(value);
+    }
+    return w;
+}
+
+/// Compute the spectrum of a channel, the results are available through get_magnitude() and get_phase() until the
+/// next call
+/// \param channel Channel the samples belong to, used to keep the averages of each channel apart
+/// \param sequence Sequence number of the frame the samples come from, a frame already in the average is not added again
+/// \param samples Samples of the channel
+/// \param options Window, requested outputs and averaging
+void spectrum_analyzer::compute(uint32_t channel, uint64_t sequence, std::span<const float> samples, const spectrum_options &options) {
+    auto n = samples.size();
+    if(n == 0) {
+        magnitude.clear();
+        phase.clear();
+        return;
+    }
+    auto &plan = plan_for(n);
+    auto &w = window_for(options.window, n);
+    auto n_bins = plan.n_bins();
+
+    windowed.resize(n);
+    std::transform(samples.begin(), samples.end(), w.begin(), windowed.begin(), std::multiplies<>());
+    bins.resize(n_bins);
+    plan.forward(windowed.data(), bins.data());
+
+    // single sided amplitude scaling: every bin but DC and Nyquist also carries the energy of its negative twin
+    auto gain = static_cast<float>(std::accumulate(w.begin(), w.end(), 0.0));
+    magnitude.resize(n_bins);
+    for(size_t k = 0; k<n_bins; k++){
+        bool paired = k != 0 && !(n%2 == 0 && k == n/2);
+        magnitude[k] = std::abs(bins[k])*(paired ? 2.0f : 1.0f)/gain;
+    }
+
+    if(options.averages > 1){
+        if(averages.size() <= channel) averages.resize(channel + 1);
+        auto &avg = averages[channel];
+        if(avg.length != n || avg.window != options.window || avg.averages != options.averages){
+            avg = {n, options.window, options.averages, 0, 0, std::vector<float>(n_bins, 0.0f)};
+        }
+        if(avg.count == 0 || avg.sequence != sequence){
+            avg.count = std::min<uint64_t>(avg.count + 1, options.averages);
+            avg.sequence = sequence;
+            auto alpha = 1.0f/static_cast<float>(avg.count);
+            for(size_t k = 0; k<n_bins; k++){
+                auto p = magnitude[k]*magnitude[k];
+                avg.power[k] += (p - avg.power[k])*alpha;
+            }
+        }
+        for(size_t k = 0; k<n_bins; k++) magnitude[k] = std::sqrt(avg.power[k]);
+    }
+
+    if(options.db){
+        for(auto &m:magnitude) m = 20.0f*std::log10(std::max(m, 1e-20f));
+    }
+
+    if(options.phase){
+        phase.resize(n_bins);
+        for(size_t k = 0; k<n_bins; k++) phase[k] = std::arg(bins[k]);
+    } else {
+        phase.clear();
+    }
+}
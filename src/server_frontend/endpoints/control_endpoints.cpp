@@ -25,8 +25,34 @@ nlohmann::json control_endpoints::process_command(const std::string& command_str
         return process_single_write_register(arguments);
     } else if( command_string == "register_read"){
         return process_single_read_register(arguments);
+    } else if( command_string == "register_modify"){
+        return process_modify_register(arguments);
+    } else if( command_string == "register_wait"){
+        return process_wait_register(arguments);
+    } else if( command_string == "register_snapshot"){
+        return process_register_snapshot(arguments);
+    } else if( command_string == "define_register_set"){
+        return process_define_register_set(arguments);
+    } else if( command_string == "sampler_start"){
+        return process_sampler_start(arguments);
+    } else if( command_string == "sampler_stop"){
+        return process_sampler_stop();
+    } else if( command_string == "sampler_fetch"){
+        return process_sampler_fetch(arguments);
     } else if( command_string == "apply_filter"){
         return process_apply_filter(arguments);
+    } else if( command_string == "invalidate_register_cache"){
+        return process_invalidate_register_cache();
+    } else if( command_string == "bus_trace_start"){
+        return process_bus_trace_start(arguments);
+    } else if( command_string == "bus_trace_stop"){
+        return hw.stop_bus_trace();
+    } else if( command_string == "bus_trace_replay"){
+        return process_bus_trace_replay(arguments);
+    } else if( command_string == "bus_stats"){
+        return process_bus_stats(arguments);
+    } else if( command_string == "bus_flush"){
+        return process_bus_flush();
     } else {
         nlohmann::json resp;
         resp["response_code"] = responses::as_integer(responses::internal_error);
@@ -77,6 +103,150 @@ nlohmann::json control_endpoints::process_single_read_register(nlohmann::json &a
 }
 
 
+///
+/// \param arguments Object with the address of the register, the mask of the bits to change and their new value
+/// \return Success, along with the value of the register after the modification
+nlohmann::json control_endpoints::process_modify_register(nlohmann::json &arguments) {
+    nlohmann::json resp;
+    std::string error_message;
+    if(!commands::validate_schema(arguments, commands::modify_register, error_message)){
+        resp["response_code"] = responses::as_integer(responses::invalid_arg);
+        resp["data"] = "DRIVER ERROR: Invalid arguments for the modify register command\n"+ error_message;
+        return resp;
+    }
+    uint64_t address = arguments["address"];
+    uint32_t mask = arguments["mask"];
+    uint32_t value = arguments["value"];
+    resp["data"] = hw.modify_register(address, mask, value);
+    resp["response_code"] = responses::as_integer(responses::ok);
+    return resp;
+}
+
+///
+/// \param arguments Object with the address of the register, the mask of the bits to check, their expected value and
+/// the timeout in microseconds
+/// \return Success if the condition was met before the timeout, along with the last value read from the register
+nlohmann::json control_endpoints::process_wait_register(nlohmann::json &arguments) {
+    nlohmann::json resp;
+    std::string error_message;
+    if(!commands::validate_schema(arguments, commands::wait_register, error_message)){
+        resp["response_code"] = responses::as_integer(responses::invalid_arg);
+        resp["data"] = "DRIVER ERROR: Invalid arguments for the wait register command\n"+ error_message;
+        return resp;
+    }
+    uint64_t address = arguments["address"];
+    uint32_t mask = arguments["mask"];
+    uint32_t expected = arguments["expected"];
+    uint64_t timeout = arguments["timeout"];
+    uint32_t value;
+    if(hw.wait_for(address, mask, expected, std::chrono::microseconds(timeout), value)){
+        resp["response_code"] = responses::as_integer(responses::ok);
+    } else {
+        resp["response_code"] = responses::as_integer(responses::wait_timeout);
+    }
+    resp["data"] = value;
+    return resp;
+}
+
+///
+/// \param arguments Either the list of addresses to read or the name of a previously defined register set
+/// \return Success, along with the values of the registers in the same order as the addresses
+nlohmann::json control_endpoints::process_register_snapshot(nlohmann::json &arguments) {
+    nlohmann::json resp;
+    std::string error_message;
+    if(!commands::validate_schema(arguments, commands::register_snapshot, error_message)){
+        resp["response_code"] = responses::as_integer(responses::invalid_arg);
+        resp["data"] = "DRIVER ERROR: Invalid arguments for the register snapshot command\n"+ error_message;
+        return resp;
+    }
+    if(arguments.is_string()){
+        auto set = register_sets.find(arguments);
+        if(set == register_sets.end()){
+            resp["response_code"] = responses::as_integer(responses::invalid_arg);
+            resp["data"] = "DRIVER ERROR: Unknown register set " + arguments.get<std::string>() + "\n";
+            return resp;
+        }
+        resp["data"] = hw.read_snapshot(set->second);
+    } else {
+        resp["data"] = hw.read_snapshot(arguments.get<std::vector<uint64_t>>());
+    }
+    resp["response_code"] = responses::as_integer(responses::ok);
+    return resp;
+}
+
+///
+/// \param arguments Object with the name of the set and the addresses of its registers, an existing set with the same
+/// name is replaced
+/// \return Success
+nlohmann::json control_endpoints::process_define_register_set(nlohmann::json &arguments) {
+    nlohmann::json resp;
+    std::string error_message;
+    if(!commands::validate_schema(arguments, commands::register_set, error_message)){
+        resp["response_code"] = responses::as_integer(responses::invalid_arg);
+        resp["data"] = "DRIVER ERROR: Invalid arguments for the define register set command\n"+ error_message;
+        return resp;
+    }
+    std::string name = arguments["name"];
+    spdlog::info("DEFINE REGISTER SET: {0} ({1} registers)", name, arguments["addresses"].size());
+    register_sets[name] = arguments["addresses"].get<std::vector<uint64_t>>();
+    resp["response_code"] = responses::as_integer(responses::ok);
+    return resp;
+}
+
+///
+/// \param arguments Object with the addresses of the registers to sample, the sampling frequency and optionally the
+/// number of samples retained for each register
+/// \return Success
+nlohmann::json control_endpoints::process_sampler_start(nlohmann::json &arguments) {
+    nlohmann::json resp;
+    std::string error_message;
+    if(!commands::validate_schema(arguments, commands::sampler_start, error_message)){
+        resp["response_code"] = responses::as_integer(responses::invalid_arg);
+        resp["data"] = "DRIVER ERROR: Invalid arguments for the sampler start command\n"+ error_message;
+        return resp;
+    }
+    auto addresses = arguments["addresses"].get<std::vector<uint64_t>>();
+    size_t depth = std::min<size_t>(10000, register_sampler::max_samples/addresses.size());
+    if(arguments.contains("depth")) depth = arguments["depth"];
+    if(depth*addresses.size() > register_sampler::max_samples){
+        resp["response_code"] = responses::as_integer(responses::invalid_arg);
+        resp["data"] = "DRIVER ERROR: The sampler buffers can hold at most " + std::to_string(register_sampler::max_samples) +
+                       " samples across all the registers\n";
+        return resp;
+    }
+    if(!sampler) sampler = std::make_shared<register_sampler>(hw);
+    sampler->start(addresses, arguments["frequency"], depth);
+    resp["response_code"] = responses::as_integer(responses::ok);
+    return resp;
+}
+
+nlohmann::json control_endpoints::process_sampler_stop() {
+    nlohmann::json resp;
+    if(sampler) sampler->stop();
+    resp["response_code"] = responses::as_integer(responses::ok);
+    return resp;
+}
+
+///
+/// \param arguments Timestamp of the last sample already received by the client, 0 to get all the buffered samples
+/// \return Success, along with the sampled series
+nlohmann::json control_endpoints::process_sampler_fetch(nlohmann::json &arguments) {
+    nlohmann::json resp;
+    if(!arguments.is_number_integer()){
+        resp["response_code"] = responses::as_integer(responses::invalid_arg);
+        resp["data"] = "DRIVER ERROR: The argument for the sampler fetch command must be an integer timestamp\n";
+        return resp;
+    }
+    if(!sampler){
+        resp["response_code"] = responses::as_integer(responses::invalid_arg);
+        resp["data"] = "DRIVER ERROR: The register sampler has not been started\n";
+        return resp;
+    }
+    resp["data"] = sampler->fetch(arguments);
+    resp["response_code"] = responses::as_integer(responses::ok);
+    return resp;
+}
+
 ///
 /// \param Operand bitstream name
 /// \return
@@ -89,6 +259,9 @@ nlohmann::json control_endpoints::process_load_bitstream(nlohmann::json &argumen
     }
 
     std::vector<uint8_t> decoded_data = cppcodec::base64_rfc4648::decode(static_cast<std::string>(arguments));
+    // the PL registers can not be read while the fabric is reconfigured
+    std::unique_lock<std::mutex> sampler_pause;
+    if(sampler) sampler_pause = sampler->pause();
     resp["response_code"] = hw.load_bitstream(decoded_data);
     return resp;
 }
@@ -112,6 +285,71 @@ nlohmann::json control_endpoints::process_apply_filter(nlohmann::json &arguments
     return resp;
 }
 
+nlohmann::json control_endpoints::process_invalidate_register_cache() {
+    nlohmann::json resp;
+    resp["response_code"] = hw.invalidate_register_cache();
+    return resp;
+}
+
+/// Fence for the write behind mode, it only returns once all the writes issued so far have reached the hardware
+/// \return Success
+nlohmann::json control_endpoints::process_bus_flush() {
+    nlohmann::json resp;
+    resp["response_code"] = hw.flush_bus();
+    return resp;
+}
+
+///
+/// \param arguments Name of the trace file, created in the traces directory
+/// \return Success
+nlohmann::json control_endpoints::process_bus_trace_start(nlohmann::json &arguments) {
+    nlohmann::json resp;
+    if(!arguments.is_string()){
+        resp["response_code"] = responses::as_integer(responses::invalid_arg);
+        resp["data"] = "DRIVER ERROR: The argument for the bus trace start command must be the name of the trace file\n";
+        return resp;
+    }
+    resp["response_code"] = hw.start_bus_trace(arguments);
+    if(resp["response_code"] == responses::invalid_arg){
+        resp["data"] = "DRIVER ERROR: Bus trace names can only contain alphanumeric characters, dashes, underscores and dots\n";
+    } else if(resp["response_code"] == responses::driver_file_not_found){
+        resp["data"] = "DRIVER ERROR: Unable to create the bus trace, a trace with the same name may already exist\n";
+    }
+    return resp;
+}
+
+///
+/// \param arguments Object with the name of the trace and the timing mode
+/// \return Success, along with the replay statistics
+nlohmann::json control_endpoints::process_bus_trace_replay(nlohmann::json &arguments) {
+    std::string error_message;
+    if(!commands::validate_schema(arguments, commands::replay_bus_trace, error_message)){
+        nlohmann::json resp;
+        resp["response_code"] = responses::as_integer(responses::invalid_arg);
+        resp["data"] = "DRIVER ERROR: Invalid arguments for the bus trace replay command\n"+ error_message;
+        return resp;
+    }
+    return hw.replay_bus_trace(arguments["name"], arguments["original_timing"]);
+}
+
 void control_endpoints::set_accessor(const std::shared_ptr<bus_accessor> &ba) {
     hw.set_accessor(ba);
+    sampler.reset();
+}
+
+///
+/// \param arguments Object selecting whether the statistics are collected from now on and whether the counters are cleared
+/// \return Success, along with the counters for each bus region
+nlohmann::json control_endpoints::process_bus_stats(nlohmann::json &arguments) {
+    nlohmann::json resp;
+    std::string error_message;
+    if(!commands::validate_schema(arguments, commands::bus_stats, error_message)){
+        resp["response_code"] = responses::as_integer(responses::invalid_arg);
+        resp["data"] = "DRIVER ERROR: Invalid arguments for the bus stats command\n"+ error_message;
+        return resp;
+    }
+    bool reset = arguments.contains("reset") && arguments["reset"].get<bool>();
+    resp["data"] = hw.get_bus_stats(arguments["enable"], reset);
+    resp["response_code"] = responses::as_integer(responses::ok);
+    return resp;
 }
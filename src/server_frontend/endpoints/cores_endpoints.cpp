@@ -198,12 +198,55 @@ nlohmann::json cores_endpoints::process_hil_disassemble(const nlohmann::json &ar
     return resp;
 }
 
+/// Produce the hardware simulation data for a HIL specification
+/// \param arguments HIL specification, optionally extended with "hw_sim_format" ("text", "hex" or "binary") and with
+/// "hw_sim_output", the base name of a pair of files in the hardware simulation directory where the code and control
+/// plane dumps are written instead of being returned. Binary dumps can only be written to file.
+/// \return Response with the dumps (or their paths) and the output and input labels
 nlohmann::json cores_endpoints::process_hil_hardware_sim(const nlohmann::json &arguments) {
-    std::vector<std::string> results;
     nlohmann::json resp;
+    auto specs = arguments;
+    auto format = hw_sim_format::text;
+    std::string output;
+
+    if(specs.is_object() && specs.contains("hw_sim_format")) {
+        auto f = specs["hw_sim_format"];
+        if(f == "text") format = hw_sim_format::text;
+        else if(f == "hex") format = hw_sim_format::hex;
+        else if(f == "binary") format = hw_sim_format::binary;
+        else {
+            resp["response_code"] = responses::as_integer(responses::invalid_arg);
+            resp["data"] = "DRIVER ERROR: The hardware simulation format must be one of text, hex or binary\n";
+            return resp;
+        }
+        specs.erase("hw_sim_format");
+    }
+    if(specs.is_object() && specs.contains("hw_sim_output")) {
+        if(!specs["hw_sim_output"].is_string() || !bus_trace_writer::is_valid_name(specs["hw_sim_output"])) {
+            resp["response_code"] = responses::as_integer(responses::invalid_arg);
+            resp["data"] = "DRIVER ERROR: The hardware simulation output must be a plain file name\n";
+            return resp;
+        }
+        output = specs["hw_sim_output"];
+        specs.erase("hw_sim_output");
+    }
+    if(format == hw_sim_format::binary && output.empty()) {
+        resp["response_code"] = responses::as_integer(responses::invalid_arg);
+        resp["data"] = "DRIVER ERROR: Binary hardware simulation dumps can only be written to file\n";
+        return resp;
+    }
 
-
-    resp["data"] = hil.get_hardware_sim_data(arguments);
+    if(output.empty()) {
+        resp["data"] = hil.get_hardware_sim_data(specs, format);
+    } else {
+        auto sim_data = hil.write_hardware_sim_data(specs, output, format);
+        if(!sim_data) {
+            resp["response_code"] = responses::as_integer(responses::driver_file_not_found);
+            resp["data"] = "DRIVER ERROR: Unable to write the hardware simulation files\n";
+            return resp;
+        }
+        resp["data"] = *sim_data;
+    }
     resp["response_code"] = responses::as_integer(responses::ok);
     return resp;
 }
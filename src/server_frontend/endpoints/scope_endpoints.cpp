@@ -18,7 +18,7 @@
 
 nlohmann::json scope_endpoints::process_command(std::string command_string, nlohmann::json &arguments) {
     if( command_string == "read_data"){
-        return process_read_data();
+        return process_read_data(arguments);
     } else if( command_string == "set_scaling_factors") {
         return process_set_scaling_factors(arguments);
     }else if(command_string == "disable_scope_dma"){
@@ -31,6 +31,18 @@ nlohmann::json scope_endpoints::process_command(std::string command_string, nloh
         return process_set_acquisition(arguments);
     }else if(command_string == "set_scope_address"){
         return process_set_scope_address(arguments);
+    }else if(command_string == "start_recording"){
+        return process_start_recording(arguments);
+    }else if(command_string == "stop_recording"){
+        return process_stop_recording();
+    }else if(command_string == "list_recordings"){
+        return process_list_recordings();
+    }else if(command_string == "fetch_recording"){
+        return process_fetch_recording(arguments);
+    }else if(command_string == "set_software_trigger"){
+        return process_set_software_trigger(arguments);
+    }else if(command_string == "get_trigger_capture"){
+        return process_get_trigger_capture(arguments);
     }else {
         nlohmann::json resp;
         resp["response_code"] = responses::as_integer(responses::internal_error);
@@ -43,13 +55,44 @@ nlohmann::json scope_endpoints::process_command(std::string command_string, nloh
 
 
 ///
-/// \param response Pointer to the structure where the data will eventually be put
+/// \param arguments Optional object, with "binary": true the samples of each channel are returned as a binary blob of
+/// little endian 32 bit floats instead of an array of numbers, with "wait": true the command blocks for up to "timeout"
+/// milliseconds until the scope signals a new frame, with "decimation": {"mode": "minmax"|"lttb", "points": N} each
+/// channel is reduced to at most N points, with "spectrum": {"window", "output", "db", "averages"} the spectrum of each
+/// channel is returned instead of its samples
 /// \return Either success of failure depending on if the data is actually ready
-nlohmann::json scope_endpoints::process_read_data() {
+nlohmann::json scope_endpoints::process_read_data(nlohmann::json &arguments) {
     nlohmann::json resp;
+    read_data_options options;
+    if(arguments.is_object()){
+        std::string error_message;
+        if(!commands::validate_schema(arguments, commands::read_data, error_message)){
+            resp["response_code"] = responses::as_integer(responses::invalid_arg);
+            resp["data"] = "DRIVER ERROR: Invalid arguments for the read data command\n"+ error_message;
+            return resp;
+        }
+        options.binary = arguments.value("binary", false);
+        options.wait_new_data = arguments.value("wait", false);
+        options.timeout = std::chrono::milliseconds(arguments.value("timeout", options.timeout.count()));
+        if(arguments.contains("decimation")){
+            options.decimation = frame_decimator::parse_mode(arguments["decimation"]["mode"]).value_or(decimation_mode::none);
+            options.max_points = arguments["decimation"]["points"];
+        }
+        if(arguments.contains("spectrum")){
+            auto &spec = arguments["spectrum"];
+            spectrum_options so;
+            so.window = spectrum_analyzer::parse_window(spec.value("window", "hann")).value_or(spectrum_window::hann);
+            auto output = spec.value("output", "magnitude");
+            so.magnitude = output != "phase";
+            so.phase = output != "magnitude";
+            so.db = spec.value("db", false);
+            so.averages = spec.value("averages", 1u);
+            options.spectrum = so;
+        }
+    }
     std::vector<nlohmann::json> resp_data;
-    resp["response_code"] = scope.read_data(resp_data);
-    resp["data"] = resp_data;
+    resp["response_code"] = scope.read_data(resp_data, options);
+    resp["data"] = std::move(resp_data);
     return resp;
 }
 
@@ -177,6 +220,95 @@ nlohmann::json scope_endpoints::process_disable_dma(nlohmann::json &arguments) {
     return resp;
 }
 
+nlohmann::json scope_endpoints::process_start_recording(nlohmann::json &arguments) {
+    nlohmann::json resp;
+    std::string error_message;
+    if(!commands::validate_schema(arguments, commands::start_recording, error_message)){
+        resp["response_code"] = responses::as_integer(responses::invalid_arg);
+        resp["data"] = "DRIVER ERROR: Invalid arguments for the start recording command\n"+ error_message;
+        return resp;
+    }
+    uint64_t segment_size = arguments.value("segment_size", frame_recorder::default_segment_size);
+    auto code = scope.start_recording(arguments["name"], segment_size);
+    resp["response_code"] = code;
+    if(code == responses::internal_error)
+        resp["data"] = "DRIVER ERROR: Not enough memory to start the recording\n";
+    else if(code != responses::ok)
+        resp["data"] = "DRIVER ERROR: Unable to start the recording, either a recording is already running or the name is already in use\n";
+    return resp;
+}
+
+nlohmann::json scope_endpoints::process_stop_recording() {
+    nlohmann::json resp;
+    resp["response_code"] = scope.stop_recording();
+    return resp;
+}
+
+nlohmann::json scope_endpoints::process_list_recordings() {
+    nlohmann::json resp;
+    resp["response_code"] = responses::ok;
+    resp["data"] = scope.get_recordings();
+    return resp;
+}
+
+nlohmann::json scope_endpoints::process_fetch_recording(nlohmann::json &arguments) {
+    nlohmann::json resp;
+    std::string error_message;
+    if(!commands::validate_schema(arguments, commands::fetch_recording, error_message)){
+        resp["response_code"] = responses::as_integer(responses::invalid_arg);
+        resp["data"] = "DRIVER ERROR: Invalid arguments for the fetch recording command\n"+ error_message;
+        return resp;
+    }
+    std::vector<nlohmann::json> frames;
+    resp["response_code"] = scope.fetch_recording(arguments["name"], arguments.value("first", uint64_t{0}), arguments.value("count", uint64_t{64}), frames);
+    resp["data"] = std::move(frames);
+    return resp;
+}
+
+nlohmann::json scope_endpoints::process_set_software_trigger(nlohmann::json &arguments) {
+    nlohmann::json resp;
+    std::string error_message;
+    if(!commands::validate_schema(arguments, commands::software_trigger, error_message)){
+        resp["response_code"] = responses::as_integer(responses::invalid_arg);
+        resp["data"] = "DRIVER ERROR: Invalid arguments for the set software trigger command\n"+ error_message;
+        return resp;
+    }
+    std::optional<trigger_config> cfg;
+    if(arguments["enabled"].get<bool>()){
+        cfg = trigger_config();
+        cfg->combine_and = arguments.value("combine", "and") == "and";
+        cfg->pre_trigger = arguments.value("pre_trigger", 0u);
+        cfg->post_trigger = arguments.value("post_trigger", 1u);
+        for(auto &c:arguments.value("conditions", nlohmann::json::array())){
+            trigger_condition cond;
+            cond.type = software_trigger::parse_type(c["type"]).value_or(trigger_condition_type::edge);
+            cond.polarity = software_trigger::parse_polarity(c.value("polarity", "positive")).value_or(trigger_polarity::positive);
+            cond.channel = c["channel"];
+            cond.level = c.value("level", 0.0f);
+            cond.upper = c.value("upper", 0.0f);
+            cond.min_width = c.value("min_width", cond.min_width);
+            cond.max_width = c.value("max_width", cond.max_width);
+            cfg->conditions.push_back(cond);
+        }
+    }
+    resp["response_code"] = scope.set_software_trigger(cfg);
+    if(resp["response_code"] != responses::ok)
+        resp["data"] = "DRIVER ERROR: The software trigger needs at least one condition, on existing channels, and windows that fit in memory\n";
+    return resp;
+}
+
+///
+/// \param arguments Optional object, with "binary": true the samples of each channel are returned as a binary blob
+/// \return The last capture of the software trigger, or no_new_data if none was completed since the previous call
+nlohmann::json scope_endpoints::process_get_trigger_capture(nlohmann::json &arguments) {
+    nlohmann::json resp;
+    bool binary = arguments.is_object() && arguments.value("binary", false);
+    nlohmann::json capture;
+    resp["response_code"] = scope.read_trigger_capture(capture, binary);
+    resp["data"] = std::move(capture);
+    return resp;
+}
+
 void scope_endpoints::set_accessor(const std::shared_ptr<bus_accessor> &ba, const std::shared_ptr<scope_accessor> &sa) {
     scope.set_accessors(ba, sa);
 }
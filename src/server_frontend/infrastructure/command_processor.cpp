@@ -26,22 +26,28 @@ nlohmann::json command_processor::process_command(std::string command_string, nl
 
     spdlog::trace("Received command: {0}", command_string);
 
-    if(commands::control_commands.contains(command_string)){
-        response_obj["body"] = control_ep.process_command(command_string, arguments);
-    } else if(commands::scope_commands.contains(command_string)){
-        response_obj["body"] = scope_ep.process_command(command_string, arguments);
-    } else if(commands::core_commands.contains(command_string)) {
-        response_obj["body"] = cores_ep.process_command(command_string, arguments);
-    } else if(commands::platform_commands.contains(command_string)){
-        response_obj["body"] = platform_ep.process_command(command_string, arguments);
-    } else if(commands::infrastructure_commands.contains(command_string)){
-        if(command_string == "null"){
-            response_obj["body"] = process_null();
+    try{
+        if(commands::control_commands.contains(command_string)){
+            response_obj["body"] = control_ep.process_command(command_string, arguments);
+        } else if(commands::scope_commands.contains(command_string)){
+            response_obj["body"] = scope_ep.process_command(command_string, arguments);
+        } else if(commands::core_commands.contains(command_string)) {
+            response_obj["body"] = cores_ep.process_command(command_string, arguments);
+        } else if(commands::platform_commands.contains(command_string)){
+            response_obj["body"] = platform_ep.process_command(command_string, arguments);
+        } else if(commands::infrastructure_commands.contains(command_string)){
+            if(command_string == "null"){
+                response_obj["body"] = process_null();
+            }
+        } else{
+            response_obj["body"] = nlohmann::json();
+            response_obj["body"]["response_code"] = responses::as_integer(responses::invalid_cmd_schema);
+            response_obj["body"]["data"] = "DRIVER ERROR: Unknown command received\n";
         }
-    } else{
+    } catch (invalid_bus_access &e){
         response_obj["body"] = nlohmann::json();
-        response_obj["body"]["response_code"] = responses::as_integer(responses::invalid_cmd_schema);
-        response_obj["body"]["data"] = "DRIVER ERROR: Unknown command received\n";
+        response_obj["body"]["response_code"] = responses::as_integer(responses::bus_access_error);
+        response_obj["body"]["data"] = std::string("DRIVER ERROR: Invalid bus access\n") + e.what();
     }
 
     return response_obj;
@@ -44,8 +44,18 @@ int main (int argc, char **argv) {
     bool external_emu = false;
     bool log_command = false;
     bool read_version = false;
+    bool shadow_registers = false;
+    bool async_log = false;
+    bool write_behind = false;
+    bool background_acquisition = false;
     std::string scope_data_source;
     int log_level = 0;
+    int bus_stats_interval = 0;
+    uint32_t scope_channels = 6;
+    uint32_t scope_buffer_size = 1024;
+    std::string recordings_dir = runtime_config.recordings_dir;
+    std::string traces_dir = runtime_config.traces_dir;
+    std::string hw_sim_dir = runtime_config.hw_sim_dir;
 
     app.add_flag("--external_emulator", external_emu, "Use external kernel emulator");
     app.add_flag("--debug_hil", debug_hil, "Write intermediate steps for hil deployment debugging");
@@ -53,6 +63,16 @@ int main (int argc, char **argv) {
     app.add_option("--log_level", log_level, "Log the received commands on the standard output");
     app.add_option("--scope_source", scope_data_source, "Path for the scope data source");
     app.add_flag("--version", read_version, "Print the software version information");
+    app.add_flag("--shadow_registers", shadow_registers, "Skip writes that would not change the value of idempotent registers");
+    app.add_flag("--async_log", async_log, "Format the hot path log messages on a background thread");
+    app.add_flag("--write_behind", write_behind, "Queue the register writes and issue them from a dedicated bus thread");
+    app.add_flag("--background_acquisition", background_acquisition, "Acquire and decode the scope frames on a dedicated thread");
+    app.add_option("--scope_channels", scope_channels, "Number of channels of the scope");
+    app.add_option("--scope_buffer_size", scope_buffer_size, "Samples per channel in a scope frame, when the kernel module can not report it");
+    app.add_option("--recordings_dir", recordings_dir, "Directory where the scope recordings are stored");
+    app.add_option("--traces_dir", traces_dir, "Directory where the bus traces are stored");
+    app.add_option("--hw_sim_dir", hw_sim_dir, "Directory where the hardware simulation dumps are written");
+    app.add_option("--bus_stats_interval", bus_stats_interval, "Collect per region bus statistics and log them every N seconds");
 
     CLI11_PARSE(app, argc, argv);
 
@@ -73,6 +93,12 @@ int main (int argc, char **argv) {
 
     runtime_config.server_port = 6666;
     runtime_config.debug_hil = debug_hil;
+    runtime_config.background_acquisition = background_acquisition;
+    runtime_config.scope_channels = scope_channels;
+    runtime_config.scope_buffer_size = scope_buffer_size;
+    runtime_config.recordings_dir = recordings_dir;
+    runtime_config.traces_dir = traces_dir;
+    runtime_config.hw_sim_dir = hw_sim_dir;
 
     if(log_command) {
         if(log_level >0) {
@@ -88,10 +114,15 @@ int main (int argc, char **argv) {
 
     spdlog::info("Logging mode: {0}", log_command);
     spdlog::info("Log level: {0}", log_level);
+    if(async_log) hot_path_logger::enable_async(65536);
 
 
     auto ba = std::make_shared<bus_accessor>();
-    auto sa = std::make_shared<scope_accessor>();
+    ba->enable_shadow(shadow_registers);
+    ba->enable_write_behind(write_behind);
+    std::unique_ptr<bus_stats_logger> stats_logger;
+    if(bus_stats_interval > 0) stats_logger = std::make_unique<bus_stats_logger>(ba, std::chrono::seconds(bus_stats_interval));
+    auto sa = std::make_shared<scope_accessor>(runtime_config.scope_channels, runtime_config.scope_buffer_size);
 
 
     //std::array<server_connector, 4> workers_pool;
@@ -17,6 +17,8 @@
 #include <gtest/gtest.h>
 
 #include "hw_interface/fpga_bridge.hpp"
+#include "hw_interface/hw_address_maps.hpp"
+#include "hw_interface/register_view.hpp"
 
 
 TEST(fpga_bridge, single_write_register_direct) {
@@ -229,6 +231,193 @@ TEST(fpga_bridge, set_scope_data) {
 
     std::filesystem::remove(if_dict.get_buffer_address_if());
 }
+TEST(fpga_bridge, shadow_registers_elide_redundant_writes) {
+
+    auto ba = std::make_shared<bus_accessor>();
+    ba->enable_shadow(true);
+    fpga_bridge bridge(true);
+    bridge.set_accessor(ba);
+
+    bridge.declare_idempotent(0x443c00004);
+
+    bridge.write_direct(0x443c00004, 12);
+    bridge.write_direct(0x443c00004, 12);
+    bridge.write_direct(0x443c00008, 12);
+    bridge.write_direct(0x443c00008, 12);
+    EXPECT_EQ(ba->get_elided_writes(), 1);
+    EXPECT_TRUE(bridge.register_holds(0x443c00004, 12));
+    EXPECT_FALSE(bridge.register_holds(0x443c00004, 13));
+    EXPECT_FALSE(bridge.register_holds(0x443c00008, 12));
+
+    bridge.write_direct(0x443c00004, 13);
+    EXPECT_EQ(ba->get_elided_writes(), 1);
+
+    bridge.invalidate_register_cache();
+    bridge.write_direct(0x443c00004, 13);
+    EXPECT_EQ(ba->get_elided_writes(), 1);
+
+    bridge.write_direct(0x443c00004, 13);
+    EXPECT_EQ(ba->get_elided_writes(), 2);
+    EXPECT_EQ(bridge.get_bus_operations().size(), 7);
+}
+
+TEST(fpga_bridge, register_block_write) {
+
+    auto ba = std::make_shared<bus_accessor>();
+    fpga_bridge bridge(true);
+    bridge.set_accessor(ba);
+
+    register_view<fcore_constant_engine_block> engine(bridge, 0x443c00000);
+    engine.write_block<
+        fcore_constant_engine_block::const_selector,
+        fcore_constant_engine_block::const_dest,
+        fcore_constant_engine_block::const_lsb
+    >(3, 0x10002, 42);
+
+    auto ops = bridge.get_bus_operations();
+    ASSERT_EQ(ops.size(), 3);
+    EXPECT_EQ(ops[0].address[0], 0x443c0000c);
+    EXPECT_EQ(ops[1].address[0], 0x443c00008);
+    EXPECT_EQ(ops[2].address[0], 0x443c00000);
+    EXPECT_EQ(ops[2].data[0], 42);
+
+    EXPECT_EQ(engine.read<fcore_constant_engine_block::const_selector>(), 3);
+    EXPECT_EQ(engine.read<fcore_constant_engine_block::const_dest>(), 0x10002);
+    EXPECT_EQ(engine.read<fcore_constant_engine_block::const_lsb>(), 42);
+}
+
+TEST(fpga_bridge, out_of_map_access) {
+
+    auto ba = std::make_shared<bus_accessor>();
+    fpga_bridge bridge(true);
+    bridge.set_accessor(ba);
+
+    EXPECT_THROW(bridge.write_direct(0x10, 1), invalid_bus_access);
+    EXPECT_THROW(bridge.read_direct(0x10), invalid_bus_access);
+
+    bridge.write_direct(0x443c00004, 12);
+    EXPECT_EQ(bridge.read_direct(0x443c00004), 12);
+}
+
+TEST(fpga_bridge, unmappable_address) {
+
+    // /dev/null can be opened but not mapped, so any access fails at mmap time, after the aperture check
+    class unmappable_backend : public null_bus_backend {
+    public:
+        unmappable_backend() : bus("/dev/null", 0x443c00000, 0x100000, "test bus") {}
+        void write_register(uint64_t address, uint32_t value) override {*bus.translate(address) = value;}
+        uint32_t read_register(uint64_t address) override {return *bus.translate(address);}
+    private:
+        mapped_bus bus;
+    };
+
+    auto ba = std::make_shared<bus_accessor>(std::make_shared<unmappable_backend>());
+    fpga_bridge bridge(true);
+    bridge.set_accessor(ba);
+
+    EXPECT_THROW(bridge.write_direct(0x443c00004, 1), invalid_bus_access);
+    EXPECT_THROW(bridge.read_direct(0x443c00004), invalid_bus_access);
+}
+
+TEST(fpga_bridge, batched_program_load) {
+
+    // a plain file stands in for the fCore programming bus, so the words that reach it can be read back
+    std::string path = "/tmp/uscope_rom_plane.bin";
+    std::ofstream(path, std::ios::binary).close();
+    std::filesystem::resize_file(path, 0x2000);
+    auto control = std::make_unique<mapped_bus>(path, 0, 0x1000, "test control bus");
+    auto cores = std::make_unique<mapped_bus>(path, 0x1000, 0x1000, "test programming bus");
+    mmap_bus_backend backend(std::move(control), std::move(cores), true);
+
+    std::vector<uint32_t> program = {0xdeadbeef, 2, 3, 0xc0ffee};
+    backend.load_program(0x1100, program.data(), program.size());
+
+    std::ifstream rom(path, std::ios::binary);
+    rom.seekg(0x1100);
+    std::vector<uint32_t> loaded(program.size());
+    rom.read(reinterpret_cast<char *>(loaded.data()), loaded.size()*sizeof(uint32_t));
+    EXPECT_EQ(loaded, program);
+    std::filesystem::remove(path);
+}
+
+TEST(fpga_bridge, simulated_backend) {
+
+    auto sim = std::make_shared<simulated_bus_backend>();
+    auto rec = std::make_shared<recording_bus_backend>(sim);
+    auto ba = std::make_shared<bus_accessor>(rec);
+    fpga_bridge bridge(true);
+    bridge.set_accessor(ba);
+
+    bridge.write_direct(0x443c00004, 12);
+    EXPECT_EQ(sim->peek_register(0x443c00004), 12);
+    EXPECT_EQ(bridge.read_direct(0x443c00004), 12);
+
+    bridge.apply_program(0x500000000, {1, 2, 3});
+    EXPECT_EQ(sim->peek_rom(0x500000008), 3);
+
+    auto t = rec->get_transactions();
+    ASSERT_EQ(t.size(), 5);
+    EXPECT_EQ(t[0].type, control_plane_write);
+    EXPECT_EQ(t[1].type, control_plane_read);
+    EXPECT_EQ(t[1].value, 12);
+    EXPECT_EQ(t[4].address, 0x500000008);
+    EXPECT_EQ(t[4].type, rom_plane_write);
+
+    ba->disable_access();
+    bridge.write_direct(0x443c00004, 15);
+    ba->enable_access();
+    EXPECT_EQ(sim->peek_register(0x443c00004), 12);
+}
+
+TEST(fpga_bridge, hardware_simulation_formats) {
+
+    auto ba = std::make_shared<bus_accessor>();
+    fpga_bridge bridge(true);
+    bridge.set_accessor(ba);
+
+    bridge.apply_program(0x500000000, {1, 0xABCD});
+    bridge.write_direct(0x443c00004, 12);
+
+    auto [rom, control] = bridge.get_hardware_simulation_data();
+    EXPECT_EQ(rom, "21474836480:1\n21474836484:43981\n");
+    EXPECT_EQ(control, "18316525572:12\n");
+
+    std::tie(rom, control) = bridge.get_hardware_simulation_data(hw_sim_format::hex);
+    EXPECT_EQ(rom, "0000000500000000 00000001\n0000000500000004 0000abcd\n");
+    EXPECT_EQ(control, "0000000443c00004 0000000c\n");
+
+    std::tie(rom, control) = bridge.get_hardware_simulation_data(hw_sim_format::binary);
+    ASSERT_EQ(rom.size(), 2*sizeof(hw_sim_record));
+    hw_sim_record r{};
+    std::memcpy(&r, rom.data() + sizeof(hw_sim_record), sizeof(r));
+    EXPECT_EQ(r.address, 0x500000004);
+    EXPECT_EQ(r.data, 0xABCD);
+}
+
+TEST(fpga_bridge, write_behind) {
+
+    auto sim = std::make_shared<simulated_bus_backend>();
+    auto ba = std::make_shared<bus_accessor>(sim);
+    ba->enable_write_behind(true, 16);
+    fpga_bridge bridge(true);
+    bridge.set_accessor(ba);
+
+    for(uint32_t i = 0; i<1000; i++){
+        bridge.write_direct(0x443c00004 + 4*(i%8), i);
+    }
+    EXPECT_EQ(bridge.read_direct(0x443c00004 + 4*7), 999);
+
+    bridge.write_proxied(0x443c00010, 0x20, 5);
+    ba->flush();
+    EXPECT_EQ(sim->peek_register(0x443c00014), 0x20);
+    EXPECT_EQ(sim->peek_register(0x443c00010), 5);
+
+    ba->enable_write_behind(false);
+    bridge.write_direct(0x443c00004, 7);
+    EXPECT_EQ(sim->peek_register(0x443c00004), 7);
+    EXPECT_EQ(bridge.get_bus_operations().size(), 1003);
+}
+
 /*
 //TODO: readd once fpga loading is handled by my driver
 
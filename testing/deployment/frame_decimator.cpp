@@ -0,0 +1,74 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "hw_interface/frame_decimator.hpp"
+
+static std::vector<float> noisy_sine(size_t n) {
+    std::mt19937 rng(7);
+    std::normal_distribution<float> noise(0, 0.05f);
+    std::vector<float> ret(n);
+    for(size_t i = 0; i<n; i++) ret[i] = std::sin(2*M_PI*3*i/n) + noise(rng);
+    return ret;
+}
+
+TEST(frame_decimator, minmax_preserves_envelope) {
+    auto samples = noisy_sine(4096);
+    samples[1234] = 25.0f;
+    samples[3000] = -25.0f;
+    frame_decimator dec;
+    auto n = dec.decimate(decimation_mode::minmax, samples, 200);
+    ASSERT_LE(n, 200);
+    auto values = dec.get_values();
+    auto indices = dec.get_indices();
+    EXPECT_TRUE(std::ranges::is_sorted(indices));
+    for(size_t i = 0; i<n; i++) EXPECT_EQ(values[i], samples[indices[i]]);
+    EXPECT_EQ(*std::ranges::max_element(values), 25.0f);
+    EXPECT_EQ(*std::ranges::min_element(values), -25.0f);
+
+    // every bucket contributes its exact extrema
+    for(size_t b = 0; b<100; b++){
+        auto bucket = std::span<const float>(samples).subspan(b*4096/100, (b + 1)*4096/100 - b*4096/100);
+        EXPECT_NE(std::ranges::find(values, *std::ranges::max_element(bucket)), values.end());
+        EXPECT_NE(std::ranges::find(values, *std::ranges::min_element(bucket)), values.end());
+    }
+}
+
+TEST(frame_decimator, lttb_keeps_ends_and_spikes) {
+    auto samples = noisy_sine(4096);
+    samples[2047] = 40.0f;
+    frame_decimator dec;
+    auto n = dec.decimate(decimation_mode::lttb, samples, 300);
+    ASSERT_EQ(n, 300);
+    auto indices = dec.get_indices();
+    EXPECT_EQ(indices.front(), 0);
+    EXPECT_EQ(indices.back(), 4095);
+    EXPECT_TRUE(std::ranges::is_sorted(indices));
+    EXPECT_NE(std::ranges::find(indices, 2047u), indices.end());
+}
+
+TEST(frame_decimator, short_channels_pass_through) {
+    std::vector<float> samples = {1, 2, 3, 4, 5};
+    frame_decimator dec;
+    for(auto mode:{decimation_mode::none, decimation_mode::minmax, decimation_mode::lttb}){
+        ASSERT_EQ(dec.decimate(mode, samples, 16), samples.size());
+        EXPECT_TRUE(std::ranges::equal(dec.get_values(), samples));
+    }
+    EXPECT_FALSE(frame_decimator::parse_mode("average").has_value());
+}
@@ -0,0 +1,100 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "hw_interface/frame_decoder.hpp"
+#include "hw_interface/channel_metadata.hpp"
+
+// Straight port of the original per sample decoding of scope_manager::shunt_data
+static std::vector<std::vector<float>> reference_decode(const std::vector<uint64_t> &words, const std::vector<float> &sf, uint32_t n_channels) {
+    std::vector<std::vector<float>> ret(n_channels);
+    for(auto w:words){
+        uint32_t channel = (w>>32) & 0xffff;
+        uint32_t raw = w & 0xffffffff;
+        auto metadata = channel_metadata(w>>48);
+        if(channel >= n_channels) continue;
+        auto size = metadata.get_size();
+        int32_t sample = raw & ((1 << size) - 1);
+        if(metadata.is_signed()){
+            int const mask = 1U << (size - 1);
+            sample = (sample ^ mask) - mask;
+        }
+        float value = sf[channel]*(float)sample;
+        if(metadata.is_float()) memcpy(&value, &raw, sizeof(float));
+        ret[channel].push_back(value);
+    }
+    return ret;
+}
+
+static void check_against_reference(uint32_t n_channels, size_t buffer_size) {
+    std::mt19937_64 rng(42);
+    std::vector<uint64_t> words(n_channels*buffer_size + 3);
+    for(auto &w:words){
+        uint64_t metadata = rng() & 0x3f;
+        uint64_t channel = rng() % (n_channels + 3);
+        w = metadata<<48 | channel<<32 | (rng() & 0xffffffff);
+    }
+    std::vector<float> sf = {1.0f, 0.5f, 1e-30f, 3.3e-3f, -7.25f, 1e30f};
+    sf.resize(n_channels, 2.0f);
+    auto reference = reference_decode(words, sf, n_channels);
+
+    for(auto k:{decode_kernel::scalar, decode_kernel::sse2, decode_kernel::avx2, decode_kernel::neon}){
+        if(!frame_decoder::is_supported(k)) continue;
+        frame_decoder decoder(k);
+        scope_frame frame(n_channels, words.size());
+        std::ranges::copy(words, frame.raw_buffer().begin());
+        frame.set_valid_words(words.size());
+        decoder.decode(frame, sf);
+        for(uint32_t c = 0; c<n_channels; c++){
+            ASSERT_EQ(frame.channel(c).size(), reference[c].size()) << frame_decoder::kernel_name(k) << " " << n_channels << " channels";
+            EXPECT_EQ(std::memcmp(frame.channel(c).data(), reference[c].data(), reference[c].size()*sizeof(float)), 0)
+                << frame_decoder::kernel_name(k) << " channel " << c;
+        }
+        EXPECT_GT(decoder.get_junk_samples(), 0);
+    }
+}
+
+TEST(frame_decoder, kernels_match_reference) {
+    check_against_reference(6, 1024);
+}
+
+TEST(frame_decoder, runtime_geometries) {
+    // specialised channel counts as well as generic ones
+    for(uint32_t n_channels:{1u, 4u, 5u, 8u, 12u, 16u}) check_against_reference(n_channels, 4096);
+}
+
+TEST(frame_decoder, channel_overflow) {
+    // a frame where a single channel carries all the words can only keep its share of the buffer
+    constexpr uint32_t n_channels = 4;
+    constexpr size_t buffer_size = 256;
+    std::vector<uint64_t> words(n_channels*buffer_size);
+    for(size_t i = 0; i<words.size(); i++) words[i] = 1ull<<32 | i;
+
+    for(auto k:{decode_kernel::scalar, decode_kernel::sse2, decode_kernel::avx2, decode_kernel::neon}){
+        if(!frame_decoder::is_supported(k)) continue;
+        frame_decoder decoder(k);
+        scope_frame frame(n_channels, words.size());
+        std::ranges::copy(words, frame.raw_buffer().begin());
+        frame.set_valid_words(words.size());
+        decoder.decode(frame, {});
+        ASSERT_EQ(frame.channel(1).size(), buffer_size) << frame_decoder::kernel_name(k);
+        EXPECT_EQ(frame.channel(0).size(), 0);
+        EXPECT_EQ(decoder.get_overflow_samples(), words.size() - buffer_size);
+    }
+}
@@ -0,0 +1,100 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "hw_interface/frame_recorder.hpp"
+
+class frame_recorder_test : public ::testing::Test {
+protected:
+    void SetUp() override {
+        root = std::filesystem::temp_directory_path() / ("uscope_recorder_test_" + std::to_string(getpid()));
+        std::filesystem::remove_all(root);
+    }
+    void TearDown() override {
+        std::filesystem::remove_all(root);
+    }
+    std::filesystem::path root;
+};
+
+TEST_F(frame_recorder_test, record_rotate_and_fetch) {
+    constexpr size_t n_words = 64;
+    constexpr uint64_t n_frames = 40;
+    frame_recorder rec(root);
+    scope_frame frame(2, n_words);
+
+    // room for 8 frames per segment
+    auto record_size = sizeof(recorded_frame_header) + n_words*sizeof(uint64_t);
+    ASSERT_TRUE(rec.start("run_1", 8*record_size, n_words));
+    EXPECT_FALSE(rec.start("run_2", 8*record_size, n_words));
+
+    for(uint64_t s = 1; s<=n_frames; s++){
+        for(size_t i = 0; i<n_words; i++) frame.raw_buffer()[i] = s<<32 | i;
+        frame.set_valid_words(n_words);
+        frame.set_sequence(s);
+        rec.record(frame);
+        // leave the writer time to drain, so that no frame is dropped
+        while(rec.get_recorded_frames() + rec.get_dropped_frames() < s) std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    rec.stop();
+    EXPECT_EQ(rec.get_dropped_frames(), 0);
+
+    auto recordings = rec.list();
+    ASSERT_EQ(recordings.size(), 1);
+    EXPECT_EQ(recordings[0].name, "run_1");
+    EXPECT_EQ(recordings[0].n_segments, 5);
+    EXPECT_EQ(recordings[0].n_frames, n_frames);
+    EXPECT_EQ(recordings[0].first_sequence, 1);
+    EXPECT_EQ(recordings[0].last_sequence, n_frames);
+
+    auto frames = rec.fetch("run_1", 7, 10);
+    ASSERT_EQ(frames.size(), 10);
+    for(uint64_t i = 0; i<frames.size(); i++){
+        EXPECT_EQ(frames[i].sequence, 7 + i);
+        ASSERT_EQ(frames[i].words.size(), n_words);
+        EXPECT_EQ(frames[i].words[5], (7 + i)<<32 | 5);
+    }
+    EXPECT_EQ(rec.fetch("run_1", 35, 100).size(), 6);
+    EXPECT_TRUE(rec.fetch("missing", 0, 10).empty());
+}
+
+TEST_F(frame_recorder_test, names) {
+    frame_recorder rec(root);
+    EXPECT_FALSE(rec.start("../escape", 4096, 16));
+    EXPECT_FALSE(rec.start("", 4096, 16));
+    ASSERT_TRUE(rec.start("ok-name_1.0", 4096, 16));
+    rec.stop();
+    // names can not be reused
+    EXPECT_FALSE(rec.start("ok-name_1.0", 4096, 16));
+}
+
+TEST_F(frame_recorder_test, queue_memory_budget) {
+    frame_recorder rec(root);
+    ASSERT_TRUE(rec.start("small", 4096, 16));
+    EXPECT_EQ(rec.get_queue_depth(), frame_recorder::max_queue_depth);
+    rec.stop();
+
+    // 4 MiB frames only get as many queue slots as fit in the budget
+    ASSERT_TRUE(rec.start("large", 0, 512*1024));
+    EXPECT_EQ(rec.get_queue_depth(), frame_recorder::queue_budget/(4*1024*1024));
+    rec.stop();
+
+    ASSERT_TRUE(rec.start("huge", 0, 4*1024*1024));
+    EXPECT_EQ(rec.get_queue_depth(), frame_recorder::min_queue_depth);
+    rec.stop();
+}
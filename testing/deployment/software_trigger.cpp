@@ -0,0 +1,147 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include "hw_interface/software_trigger.hpp"
+
+// Feed the signals to the trigger in frames, collecting every completed capture
+static std::vector<trigger_capture> run_trigger(software_trigger &trg, const std::vector<std::vector<float>> &signals, size_t frame_samples) {
+    std::vector<trigger_capture> captures;
+    auto n_channels = static_cast<uint32_t>(signals.size());
+    scope_frame frame(n_channels, n_channels*frame_samples);
+    for(size_t start = 0; start < signals[0].size(); start += frame_samples){
+        auto n = std::min(frame_samples, signals[0].size() - start);
+        for(uint32_t ch = 0; ch<n_channels; ch++){
+            std::copy_n(signals[ch].begin() + start, n, frame.channel_buffer(ch));
+            frame.set_channel_size(ch, n);
+        }
+        trigger_capture c;
+        if(trg.process(frame, c)) captures.push_back(c);
+    }
+    return captures;
+}
+
+static void add_pulse(std::vector<float> &s, size_t start, size_t width, float amplitude) {
+    std::fill_n(s.begin() + start, width, amplitude);
+}
+
+TEST(software_trigger, edge_capture_across_frames) {
+    std::vector<std::vector<float>> signals(2, std::vector<float>(8192, 0.0f));
+    for(size_t i = 0; i<8192; i++) signals[1][i] = static_cast<float>(i);
+    add_pulse(signals[0], 1020, 100, 1.0f);
+    add_pulse(signals[0], 5000, 100, 1.0f);
+
+    trigger_config cfg;
+    cfg.conditions.push_back({trigger_condition_type::edge, trigger_polarity::positive, 0, 0.5f});
+    cfg.pre_trigger = 16;
+    cfg.post_trigger = 48;
+    software_trigger trg;
+    ASSERT_TRUE(trg.configure(cfg, 2, 1024));
+
+    auto captures = run_trigger(trg, signals, 1024);
+    ASSERT_EQ(captures.size(), 2);
+    EXPECT_EQ(captures[0].trigger_position, 1020);
+    EXPECT_EQ(captures[1].trigger_position, 5000);
+    for(auto &c:captures){
+        ASSERT_EQ(c.channels[1].size(), 64);
+        // the capture is centred on the trigger sample on every channel
+        EXPECT_EQ(c.channels[1][c.pre_trigger], static_cast<float>(c.trigger_position));
+        EXPECT_EQ(c.channels[0][c.pre_trigger - 1], 0.0f);
+        EXPECT_EQ(c.channels[0][c.pre_trigger], 1.0f);
+    }
+}
+
+TEST(software_trigger, pulse_width) {
+    std::vector<std::vector<float>> signals(1, std::vector<float>(4096, 0.0f));
+    add_pulse(signals[0], 100, 5, 1.0f);
+    add_pulse(signals[0], 1000, 20, 1.0f);
+    add_pulse(signals[0], 2000, 50, 1.0f);
+
+    trigger_config cfg;
+    cfg.conditions.push_back({trigger_condition_type::pulse_width, trigger_polarity::positive, 0, 0.5f, 0, 15, 30});
+    cfg.post_trigger = 8;
+    software_trigger trg;
+    ASSERT_TRUE(trg.configure(cfg, 1, 512));
+
+    auto captures = run_trigger(trg, signals, 512);
+    ASSERT_EQ(captures.size(), 1);
+    EXPECT_EQ(captures[0].trigger_position, 1020);
+}
+
+TEST(software_trigger, runt) {
+    std::vector<std::vector<float>> signals(1, std::vector<float>(4096, 0.0f));
+    add_pulse(signals[0], 300, 40, 1.0f);
+    add_pulse(signals[0], 1500, 40, 0.5f);
+    add_pulse(signals[0], 3000, 40, 1.0f);
+
+    trigger_config cfg;
+    cfg.conditions.push_back({trigger_condition_type::runt, trigger_polarity::positive, 0, 0.2f, 0.8f});
+    software_trigger trg;
+    ASSERT_TRUE(trg.configure(cfg, 1, 1024));
+
+    auto captures = run_trigger(trg, signals, 1024);
+    ASSERT_EQ(captures.size(), 1);
+    EXPECT_EQ(captures[0].trigger_position, 1540);
+}
+
+TEST(software_trigger, window_and_qualifier) {
+    std::vector<std::vector<float>> signals(2, std::vector<float>(4096, 0.0f));
+    add_pulse(signals[0], 500, 10, 2.0f);
+    add_pulse(signals[0], 2500, 10, -2.0f);
+    add_pulse(signals[1], 2000, 1000, 1.0f);
+
+    trigger_config cfg;
+    cfg.conditions.push_back({trigger_condition_type::window, trigger_polarity::positive, 0, -1.0f, 1.0f});
+    cfg.conditions.push_back({trigger_condition_type::level, trigger_polarity::positive, 1, 0.5f});
+    software_trigger trg;
+    ASSERT_TRUE(trg.configure(cfg, 2, 1024));
+    auto captures = run_trigger(trg, signals, 1024);
+    ASSERT_EQ(captures.size(), 1);
+    EXPECT_EQ(captures[0].trigger_position, 2500);
+
+    cfg.combine_and = false;
+    cfg.conditions[1].type = trigger_condition_type::edge;
+    ASSERT_TRUE(trg.configure(cfg, 2, 1024));
+    captures = run_trigger(trg, signals, 1024);
+    ASSERT_EQ(captures.size(), 3);
+    EXPECT_EQ(captures[0].trigger_position, 500);
+    EXPECT_EQ(captures[1].trigger_position, 2000);
+    EXPECT_EQ(captures[2].trigger_position, 2500);
+
+    cfg.conditions[1].channel = 2;
+    EXPECT_FALSE(trg.configure(cfg, 2, 1024));
+}
+
+TEST(software_trigger, oversized_frames_are_skipped) {
+    std::vector<std::vector<float>> signals(1, std::vector<float>(8192, 0.0f));
+    add_pulse(signals[0], 1020, 100, 1.0f);
+    add_pulse(signals[0], 5000, 100, 1.0f);
+
+    trigger_config cfg;
+    cfg.conditions.push_back({trigger_condition_type::edge, trigger_polarity::positive, 0, 0.5f});
+    cfg.pre_trigger = 16;
+    cfg.post_trigger = 48;
+    software_trigger trg;
+    ASSERT_TRUE(trg.configure(cfg, 1, 1024));
+
+    EXPECT_TRUE(run_trigger(trg, signals, 2048).empty());
+    EXPECT_EQ(trg.get_oversized_frames(), 4);
+    EXPECT_TRUE(trg.is_enabled());
+
+    // frames of the configured depth are still processed
+    EXPECT_EQ(run_trigger(trg, signals, 1024).size(), 2);
+}
@@ -0,0 +1,153 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <cmath>
+#include <numbers>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "hw_interface/fft_plan.hpp"
+#include "hw_interface/spectrum_analyzer.hpp"
+
+static std::vector<std::complex<double>> naive_dft(const std::vector<std::complex<float>> &x) {
+    auto n = x.size();
+    std::vector<std::complex<double>> ret(n);
+    for(size_t k = 0; k<n; k++){
+        for(size_t j = 0; j<n; j++){
+            auto angle = -2.0*std::numbers::pi*static_cast<double>((k*j)%n)/static_cast<double>(n);
+            ret[k] += std::complex<double>(x[j])*std::polar(1.0, angle);
+        }
+    }
+    return ret;
+}
+
+static std::vector<std::complex<float>> random_signal(size_t n) {
+    std::mt19937 rng(static_cast<uint32_t>(n));
+    std::uniform_real_distribution<float> d(-1, 1);
+    std::vector<std::complex<float>> ret(n);
+    for(auto &v:ret) v = {d(rng), d(rng)};
+    return ret;
+}
+
+TEST(fft_plan, matches_dft) {
+    // power of two lengths use the radix-2 transform, the others go through Bluestein's algorithm
+    for(size_t n:{1ul, 2ul, 8ul, 1024ul, 3ul, 7ul, 1000ul, 1536ul}){
+        auto x = random_signal(n);
+        auto reference = naive_dft(x);
+        fft_plan plan(n);
+        plan.forward(x.data());
+        for(size_t k = 0; k<n; k++){
+            ASSERT_NEAR(x[k].real(), reference[k].real(), 2e-3*std::sqrt(n)) << "n = " << n << " bin " << k;
+            ASSERT_NEAR(x[k].imag(), reference[k].imag(), 2e-3*std::sqrt(n)) << "n = " << n << " bin " << k;
+        }
+    }
+}
+
+TEST(fft_plan, real_matches_dft) {
+    for(size_t n:{2ul, 1024ul, 1000ul, 999ul}){
+        auto x = random_signal(n);
+        std::vector<float> real(n);
+        for(size_t i = 0; i<n; i++){
+            real[i] = x[i].real();
+            x[i] = {x[i].real(), 0};
+        }
+        auto reference = naive_dft(x);
+        real_fft_plan plan(n);
+        std::vector<std::complex<float>> bins(plan.n_bins());
+        plan.forward(real.data(), bins.data());
+        for(size_t k = 0; k<plan.n_bins(); k++){
+            ASSERT_NEAR(bins[k].real(), reference[k].real(), 2e-3*std::sqrt(n)) << "n = " << n << " bin " << k;
+            ASSERT_NEAR(bins[k].imag(), reference[k].imag(), 2e-3*std::sqrt(n)) << "n = " << n << " bin " << k;
+        }
+    }
+}
+
+TEST(spectrum_analyzer, sine_amplitude) {
+    constexpr size_t n = 1024;
+    std::vector<float> samples(n);
+    for(size_t i = 0; i<n; i++) samples[i] = 1.5f + 3.0f*std::sin(2*std::numbers::pi*50*i/n);
+
+    spectrum_analyzer analyzer;
+    spectrum_options opt;
+    opt.window = spectrum_window::rectangular;
+    opt.phase = true;
+    analyzer.compute(0, 0, samples, opt);
+    auto mag = analyzer.get_magnitude();
+    ASSERT_EQ(mag.size(), n/2 + 1);
+    EXPECT_NEAR(mag[0], 1.5f, 1e-3);
+    EXPECT_NEAR(mag[50], 3.0f, 1e-3);
+    EXPECT_NEAR(mag[51], 0.0f, 1e-3);
+    // a sine has a phase of -pi/2 with respect to the cosine basis
+    EXPECT_NEAR(analyzer.get_phase()[50], -std::numbers::pi/2, 1e-3);
+
+    // the flat top window keeps the amplitude of a tone falling between two bins
+    for(size_t i = 0; i<n; i++) samples[i] = 3.0f*std::sin(2*std::numbers::pi*100.5*i/n);
+    opt.window = spectrum_window::flat_top;
+    opt.phase = false;
+    analyzer.compute(0, 0, samples, opt);
+    mag = analyzer.get_magnitude();
+    EXPECT_NEAR(*std::max_element(mag.begin(), mag.end()), 3.0f, 0.01f);
+
+    opt.db = true;
+    analyzer.compute(0, 0, samples, opt);
+    EXPECT_NEAR(*std::max_element(analyzer.get_magnitude().begin(), analyzer.get_magnitude().end()), 20*std::log10(3.0f), 0.05f);
+}
+
+TEST(spectrum_analyzer, averaging_reduces_noise) {
+    constexpr size_t n = 512;
+    std::mt19937 rng(3);
+    std::normal_distribution<float> noise(0, 1);
+    std::vector<float> samples(n);
+    spectrum_analyzer analyzer;
+    spectrum_options opt;
+    opt.averages = 64;
+
+    auto spread = [&]{
+        auto mag = analyzer.get_magnitude();
+        float mean = 0, sq = 0;
+        for(size_t k = 1; k<mag.size() - 1; k++) {mean += mag[k]; sq += mag[k]*mag[k];}
+        mean /= mag.size() - 2;
+        return std::sqrt(sq/(mag.size() - 2) - mean*mean)/mean;
+    };
+    for(auto &s:samples) s = noise(rng);
+    analyzer.compute(0, 0, samples, opt);
+    auto single = spread();
+    for(int i = 0; i<63; i++){
+        for(auto &s:samples) s = noise(rng);
+        analyzer.compute(0, i + 1, samples, opt);
+    }
+    EXPECT_LT(spread(), single/4);
+}
+
+TEST(spectrum_analyzer, averaging_counts_each_frame_once) {
+    constexpr size_t n = 256;
+    std::vector<float> first(n), second(n);
+    for(size_t i = 0; i<n; i++){
+        first[i] = std::sin(2*std::numbers::pi*8*i/n);
+        second[i] = 3*first[i];
+    }
+    spectrum_analyzer analyzer;
+    spectrum_options opt;
+    opt.window = spectrum_window::rectangular;
+    opt.averages = 4;
+
+    analyzer.compute(0, 1, first, opt);
+    analyzer.compute(0, 1, second, opt);
+    EXPECT_NEAR(analyzer.get_magnitude()[8], 1.0f, 1e-3f);
+
+    // RMS average of the two frames
+    analyzer.compute(0, 2, second, opt);
+    EXPECT_NEAR(analyzer.get_magnitude()[8], std::sqrt(5.0f), 1e-3f);
+}
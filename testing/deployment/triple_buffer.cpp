@@ -0,0 +1,65 @@
+//   Copyright 2025 Filippo Savi <filssavi@gmail.com>
+//
+//   Licensed under the Apache License, Version 2.0 (the "License");
+//   you may not use this file except in compliance with the License.
+//   You may obtain a copy of the License at
+//
+//       http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "hw_interface/triple_buffer.hpp"
+
+TEST(triple_buffer, latest_value_wins) {
+    triple_buffer<int> buf(0);
+    EXPECT_FALSE(buf.update());
+
+    buf.back() = 1;
+    buf.publish();
+    buf.back() = 2;
+    buf.publish();
+
+    EXPECT_TRUE(buf.update());
+    EXPECT_EQ(buf.front(), 2);
+    EXPECT_FALSE(buf.update());
+    EXPECT_EQ(buf.front(), 2);
+
+    buf.back() = 3;
+    buf.publish();
+    EXPECT_TRUE(buf.update());
+    EXPECT_EQ(buf.front(), 3);
+}
+
+TEST(triple_buffer, concurrent_handoff) {
+    struct payload {
+        uint64_t a = 0;
+        uint64_t b = 0;
+    };
+    triple_buffer<payload> buf;
+    constexpr uint64_t n_values = 200000;
+
+    std::thread producer([&buf]{
+        for(uint64_t i = 1; i<=n_values; i++){
+            buf.back() = {i, ~i};
+            buf.publish();
+        }
+    });
+
+    uint64_t last = 0;
+    while(last < n_values){
+        if(!buf.update()) continue;
+        auto &p = buf.front();
+        ASSERT_EQ(p.b, ~p.a);
+        ASSERT_GT(p.a, last);
+        last = p.a;
+    }
+    producer.join();
+}
@@ -112,6 +112,49 @@ TEST(control_endpoints, read_register) {
 
 
 
+TEST(control_endpoints, modify_register) {
+
+    auto command = nlohmann::json::parse(R"(
+    {
+        "address": 18316525568,
+        "mask": 3840,
+        "value": 1280
+    })");
+
+    auto ba = std::make_shared<bus_accessor>();
+
+    control_endpoints ep(true);
+    ep.set_accessor(ba);
+    auto resp = ep.process_command("register_modify", command);
+
+    EXPECT_EQ(resp["response_code"], responses::ok);
+    auto ops = ba->get_operations();
+    ASSERT_EQ(ops.size(), 2);
+    EXPECT_EQ(ops[0].type, control_plane_read);
+    EXPECT_EQ(ops[1].type, control_plane_write);
+    EXPECT_EQ(ops[1].address[0], 18316525568);
+    EXPECT_EQ(ops[1].data[0], (ops[0].data[0] & ~0xF00) | 0x500);
+    EXPECT_EQ(resp["data"], ops[1].data[0]);
+}
+
+TEST(control_endpoints, modify_register_non_validating) {
+
+    auto command = nlohmann::json::parse(R"(
+    {
+        "address": 18316525568,
+        "value": 1280
+    })");
+
+    auto ba = std::make_shared<bus_accessor>();
+
+    control_endpoints ep(true);
+    ep.set_accessor(ba);
+    auto resp = ep.process_command("register_modify", command);
+
+    EXPECT_EQ(resp["response_code"], responses::invalid_arg);
+    EXPECT_EQ(ba->get_operations().size(), 0);
+}
+
 
 TEST(control_endpoints, read_non_register) {
 
@@ -127,4 +170,257 @@ TEST(control_endpoints, read_non_register) {
     auto ops = ba->get_operations();
     EXPECT_EQ(resp["data"], "DRIVER ERROR:The argument for the single read register call must be a numeric value\n");
     EXPECT_GE(ops.size(), 0);
-}
\ No newline at end of file
+}
+TEST(control_endpoints, bus_trace_capture_and_replay) {
+
+    auto ba = std::make_shared<bus_accessor>(std::make_shared<simulated_bus_backend>());
+
+    control_endpoints ep(true);
+    ep.set_accessor(ba);
+
+    std::filesystem::remove(std::filesystem::path(runtime_config.traces_dir) / "bus_trace.bin");
+    nlohmann::json name = "bus_trace.bin";
+    auto resp = ep.process_command("bus_trace_start", name);
+    EXPECT_EQ(resp["response_code"], responses::ok);
+
+    auto command = nlohmann::json::parse(R"(
+    {
+        "address": 18316525568,
+        "proxy_address": 0,
+        "proxy_type": "",
+        "type": "direct",
+        "value": 1280
+    })");
+    ep.process_command("register_write", command);
+    command["value"] = 42;
+    ep.process_command("register_write", command);
+
+    nlohmann::json no_args;
+    resp = ep.process_command("bus_trace_stop", no_args);
+    EXPECT_EQ(resp["data"], 2);
+
+    auto target = std::make_shared<simulated_bus_backend>();
+    ba->set_backend(target);
+    auto replay = nlohmann::json::parse(R"({"name": "bus_trace.bin", "original_timing": false})");
+    resp = ep.process_command("bus_trace_replay", replay);
+
+    EXPECT_EQ(resp["response_code"], responses::ok);
+    EXPECT_EQ(resp["data"]["n_transactions"], 2);
+    EXPECT_EQ(target->peek_register(18316525568), 42);
+
+    std::filesystem::remove(std::filesystem::path(runtime_config.traces_dir) / "bus_trace.bin");
+}
+
+TEST(control_endpoints, bus_trace_names_are_confined) {
+
+    auto ba = std::make_shared<bus_accessor>(std::make_shared<simulated_bus_backend>());
+
+    control_endpoints ep(true);
+    ep.set_accessor(ba);
+
+    for(auto &bad:{"/tmp/uscope_escaped_trace.bin", "../uscope_escaped_trace.bin", "sub/trace.bin", ".."}){
+        nlohmann::json name = bad;
+        auto resp = ep.process_command("bus_trace_start", name);
+        EXPECT_EQ(resp["response_code"], responses::invalid_arg);
+
+        nlohmann::json replay;
+        replay["name"] = bad;
+        replay["original_timing"] = false;
+        resp = ep.process_command("bus_trace_replay", replay);
+        EXPECT_EQ(resp["response_code"], responses::invalid_arg);
+    }
+    EXPECT_FALSE(std::filesystem::exists("/tmp/uscope_escaped_trace.bin"));
+}
+
+TEST(control_endpoints, wait_register) {
+
+    auto sim = std::make_shared<simulated_bus_backend>();
+    auto ba = std::make_shared<bus_accessor>(sim);
+
+    control_endpoints ep(true);
+    ep.set_accessor(ba);
+
+    auto command = nlohmann::json::parse(R"(
+    {
+        "address": 18316525568,
+        "mask": 2,
+        "expected": 2,
+        "timeout": 2000
+    })");
+
+    auto resp = ep.process_command("register_wait", command);
+    EXPECT_EQ(resp["response_code"], responses::wait_timeout);
+
+    sim->write_register(18316525568, 3);
+    resp = ep.process_command("register_wait", command);
+    EXPECT_EQ(resp["response_code"], responses::ok);
+    EXPECT_EQ(resp["data"], 3);
+    EXPECT_EQ(ba->get_operations().size(), 2);
+
+    command["timeout"] = 3600'000'000;
+    resp = ep.process_command("register_wait", command);
+    EXPECT_EQ(resp["response_code"], responses::invalid_arg);
+}
+
+TEST(control_endpoints, register_snapshot) {
+
+    auto sim = std::make_shared<simulated_bus_backend>();
+    auto ba = std::make_shared<bus_accessor>(sim);
+    sim->write_register(0x443c00000, 1);
+    sim->write_register(0x443c00004, 2);
+    sim->write_register(0x443c00008, 3);
+
+    control_endpoints ep(true);
+    ep.set_accessor(ba);
+
+    auto command = nlohmann::json::parse(R"([18316525576, 18316525568])");
+    auto resp = ep.process_command("register_snapshot", command);
+    EXPECT_EQ(resp["response_code"], responses::ok);
+    std::vector<uint32_t> ref = {3, 1};
+    EXPECT_EQ(resp["data"], ref);
+
+    command = nlohmann::json::parse(R"({"name": "status", "addresses": [18316525568, 18316525572, 18316525576]})");
+    resp = ep.process_command("define_register_set", command);
+    EXPECT_EQ(resp["response_code"], responses::ok);
+
+    command = "status";
+    resp = ep.process_command("register_snapshot", command);
+    ref = {1, 2, 3};
+    EXPECT_EQ(resp["data"], ref);
+    EXPECT_EQ(ba->get_operations().size(), 2);
+
+    command = "missing";
+    resp = ep.process_command("register_snapshot", command);
+    EXPECT_EQ(resp["response_code"], responses::invalid_arg);
+}
+
+TEST(control_endpoints, register_sampler) {
+
+    auto sim = std::make_shared<simulated_bus_backend>();
+    auto ba = std::make_shared<bus_accessor>(sim);
+    sim->write_register(0x443c00000, 7);
+
+    control_endpoints ep(true);
+    ep.set_accessor(ba);
+
+    auto command = nlohmann::json::parse(R"({"addresses": [18316525568], "frequency": 1000, "depth": 100})");
+    auto resp = ep.process_command("sampler_start", command);
+    EXPECT_EQ(resp["response_code"], responses::ok);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    nlohmann::json since = 0;
+    resp = ep.process_command("sampler_fetch", since);
+    EXPECT_EQ(resp["response_code"], responses::ok);
+    auto series = resp["data"]["series"][0];
+    ASSERT_GT(series["values"].size(), 0);
+    EXPECT_EQ(series["values"][0], 7);
+
+    nlohmann::json no_args;
+    ep.process_command("sampler_stop", no_args);
+
+    since = series["timestamps"].back();
+    resp = ep.process_command("sampler_fetch", since);
+    auto new_samples = resp["data"]["series"][0]["values"].size();
+    resp = ep.process_command("sampler_fetch", since);
+    EXPECT_EQ(resp["data"]["series"][0]["values"].size(), new_samples);
+    EXPECT_EQ(ba->get_operations().size(), 0);
+}
+
+TEST(control_endpoints, register_sampler_limits_and_errors) {
+
+    class failing_backend : public null_bus_backend {
+    public:
+        uint32_t read_register(uint64_t address) override {throw invalid_bus_access("unmappable register");}
+    };
+    auto ba = std::make_shared<bus_accessor>(std::make_shared<failing_backend>());
+
+    control_endpoints ep(true);
+    ep.set_accessor(ba);
+
+    auto command = nlohmann::json::parse(R"({"addresses": [18316525568, 18316525572], "frequency": 1000, "depth": 1000000})");
+    auto resp = ep.process_command("sampler_start", command);
+    EXPECT_EQ(resp["response_code"], responses::invalid_arg);
+
+    command["depth"] = 100;
+    resp = ep.process_command("sampler_start", command);
+    EXPECT_EQ(resp["response_code"], responses::ok);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    nlohmann::json no_args;
+    resp = ep.process_command("sampler_stop", no_args);
+    EXPECT_EQ(resp["response_code"], responses::ok);
+}
+
+TEST(control_endpoints, bus_flush) {
+
+    auto command = nlohmann::json::parse(R"(
+    {
+        "address": 18316525568,
+        "value": 3122,
+        "type": "direct",
+        "proxy_address": 0,
+        "proxy_type":""
+    })");
+
+    auto sim = std::make_shared<simulated_bus_backend>();
+    auto ba = std::make_shared<bus_accessor>(sim);
+    ba->enable_write_behind(true, 16);
+
+    control_endpoints ep(true);
+    ep.set_accessor(ba);
+    auto resp = ep.process_command("register_write", command);
+    EXPECT_EQ(resp["response_code"], responses::ok);
+
+    nlohmann::json no_args;
+    resp = ep.process_command("bus_flush", no_args);
+    EXPECT_EQ(resp["response_code"], responses::ok);
+    EXPECT_EQ(sim->peek_register(18316525568), 3122);
+    ba->enable_write_behind(false);
+}
+
+TEST(control_endpoints, bus_stats) {
+
+    auto ba = std::make_shared<bus_accessor>(std::make_shared<simulated_bus_backend>());
+    ba->define_region("scope", 0x443c00000, 0x300);
+    ba->define_region("controller", 0x443c10000, 0);
+
+    control_endpoints ep(true);
+    ep.set_accessor(ba);
+
+    auto stats_cmd = nlohmann::json::parse(R"({"enable": true})");
+    auto resp = ep.process_command("bus_stats", stats_cmd);
+    EXPECT_EQ(resp["response_code"], responses::ok);
+
+    auto command = nlohmann::json::parse(R"(
+    {
+        "address": 18316525572,
+        "proxy_address": 0,
+        "proxy_type": "",
+        "type": "direct",
+        "value": 12
+    })");
+    ep.process_command("register_write", command);
+    ep.process_command("register_write", command);
+    nlohmann::json read_addr = 0x443c10010;
+    ep.process_command("register_read", read_addr);
+    ba->write_register(0x10, 1);
+
+    stats_cmd["reset"] = true;
+    resp = ep.process_command("bus_stats", stats_cmd);
+    EXPECT_EQ(resp["response_code"], responses::ok);
+    auto regions = resp["data"]["regions"];
+    ASSERT_EQ(regions.size(), 3);
+    EXPECT_EQ(regions[0]["name"], "scope");
+    EXPECT_EQ(regions[0]["writes"], 2);
+    EXPECT_EQ(regions[0]["bytes"], 8);
+    EXPECT_EQ(regions[1]["name"], "controller");
+    EXPECT_EQ(regions[1]["reads"], 1);
+    EXPECT_EQ(regions[2]["name"], "unmapped");
+    EXPECT_EQ(regions[2]["writes"], 1);
+
+    stats_cmd = nlohmann::json::parse(R"({"enable": false})");
+    resp = ep.process_command("bus_stats", stats_cmd);
+    EXPECT_EQ(resp["data"]["regions"][0]["writes"], 0);
+    EXPECT_FALSE(ba->stats_enabled());
+}
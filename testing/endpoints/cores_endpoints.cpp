@@ -14,6 +14,8 @@
 
 
 
+#include <filesystem>
+
 #include <gtest/gtest.h>
 #include "server_frontend/endpoints/cores_endpoints.hpp"
 #include "../hil_addresses.hpp"
@@ -190,6 +192,44 @@ TEST(cores_endpoints, cache_invalidation_hil_sim_data) {
     EXPECT_EQ(control_res, control_ref);
 }
 
+TEST(cores_endpoints, hil_sim_data_formats) {
+
+    nlohmann::json command = nlohmann::json::parse(default_hil_spec);
+
+    auto ba = std::make_shared<bus_accessor>();
+
+    cores_endpoints ep(true);
+    ep.set_accessor(ba);
+    ep.process_command("set_hil_address_map", addr_map_v2);
+
+    command["hw_sim_format"] = "hex";
+    auto resp = ep.process_command("hil_hardware_sim", command);
+    ASSERT_EQ(resp["response_code"], responses::as_integer(responses::ok));
+    std::string rom_res = resp["data"]["code"];
+    EXPECT_EQ(rom_res.substr(0, 26), "0000000500000000 00050004\n");
+
+    command["hw_sim_format"] = "binary";
+    resp = ep.process_command("hil_hardware_sim", command);
+    EXPECT_EQ(resp["response_code"], responses::as_integer(responses::invalid_arg));
+
+    command["hw_sim_output"] = "../escape";
+    resp = ep.process_command("hil_hardware_sim", command);
+    EXPECT_EQ(resp["response_code"], responses::as_integer(responses::invalid_arg));
+
+    runtime_config.hw_sim_dir = std::filesystem::temp_directory_path() / "uscope_hw_sim_test";
+    command["hw_sim_output"] = "sim";
+    resp = ep.process_command("hil_hardware_sim", command);
+    ASSERT_EQ(resp["response_code"], responses::as_integer(responses::ok));
+    std::string code_path = resp["data"]["code"];
+    std::string control_path = resp["data"]["control"];
+    EXPECT_EQ(code_path, runtime_config.hw_sim_dir + "/sim_code.bin");
+    EXPECT_EQ(std::filesystem::file_size(code_path), 12*sizeof(hw_sim_record));
+    EXPECT_EQ(std::filesystem::file_size(control_path), 23*sizeof(hw_sim_record));
+    EXPECT_EQ(resp["data"]["outputs"], "2:test.out[0]\n65539:test.out[1]\n");
+
+    std::filesystem::remove_all(runtime_config.hw_sim_dir);
+}
+
 TEST(cores_endpoints, deploy_hil) {
     nlohmann::json command = nlohmann::json::parse(default_hil_spec);
 